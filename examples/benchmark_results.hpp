@@ -0,0 +1,114 @@
+#pragma once
+
+/*
+MIT License
+Copyright (c) 2019 Arlen Keshabyan (arlen.albert@gmail.com)
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <chrono>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Collects the measurements of all benchmarks and writes them as JSON or CSV
+ *
+ * Every measurement is a row of benchmark, variant, parameter, metric, value and unit,
+ * so results of different versions can be joined on the first four columns.
+ */
+class benchmark_results
+{
+public:
+    void add(std::string_view benchmark, std::string_view variant, std::string_view parameter, std::string_view metric, double value, std::string_view unit)
+    {
+        _rows.push_back({ std::string { benchmark }, std::string { variant }, std::string { parameter }, std::string { metric }, value, std::string { unit } });
+    }
+
+    /**
+     * @brief Adds the mean and the percentiles of a latency histogram, such as nstd::signal_slot::latency_histogram
+     */
+    template<typename Histogram>
+    void add_latency(std::string_view benchmark, std::string_view variant, std::string_view parameter, const Histogram &latency)
+    {
+        add(benchmark, variant, parameter, "latency_mean", static_cast<double>(latency.mean()), "ns");
+        add(benchmark, variant, parameter, "latency_p50", static_cast<double>(latency.percentile(50)), "ns");
+        add(benchmark, variant, parameter, "latency_p99", static_cast<double>(latency.percentile(99)), "ns");
+        add(benchmark, variant, parameter, "latency_p999", static_cast<double>(latency.percentile(99.9)), "ns");
+        add(benchmark, variant, parameter, "latency_max", static_cast<double>(latency.max()), "ns");
+    }
+
+    std::string to_json(std::string_view label) const
+    {
+        std::ostringstream json;
+
+        json << std::fixed << std::setprecision(3);
+        json << "{\"label\":\"" << escape(label) << "\",\"timestamp\":" << std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count()
+             << ",\"hardware_threads\":" << std::thread::hardware_concurrency() << ",\"results\":[";
+
+        for (size_t i = 0; i < std::size(_rows); ++i)
+        {
+            auto &row { _rows[i] };
+
+            json << (i ? "," : "") << "{\"benchmark\":\"" << escape(row.benchmark) << "\",\"variant\":\"" << escape(row.variant) << "\",\"parameter\":\"" << escape(row.parameter)
+                 << "\",\"metric\":\"" << escape(row.metric) << "\",\"value\":" << row.value << ",\"unit\":\"" << escape(row.unit) << "\"}";
+        }
+
+        json << "]}\n";
+
+        return json.str();
+    }
+
+    std::string to_csv(std::string_view label) const
+    {
+        std::ostringstream csv;
+
+        csv << std::fixed << std::setprecision(3);
+        csv << "label,benchmark,variant,parameter,metric,value,unit\n";
+
+        for (auto &&row : _rows) csv << label << ',' << row.benchmark << ',' << row.variant << ',' << row.parameter << ',' << row.metric << ',' << row.value << ',' << row.unit << '\n';
+
+        return csv.str();
+    }
+
+private:
+    struct row
+    {
+        std::string benchmark, variant, parameter, metric;
+        double value;
+        std::string unit;
+    };
+
+    std::vector<row> _rows {};
+
+    static std::string escape(std::string_view text)
+    {
+        std::string escaped;
+
+        for (auto c : text)
+        {
+            if (c == '"' || c == '\\') escaped += '\\';
+
+            escaped += c;
+        }
+
+        return escaped;
+    }
+};
@@ -169,6 +169,58 @@ solution "nstd_examples"
         configuration "linux or macosx or bsd"
             links { "pthread" }
 
+    project "signal_slot_example"
+        files { "signal_slot_example.cpp" }
+        configuration { "Debug" }
+            objdir "obj/signal_slot_example/Debug"
+            targetdir "bin/signal_slot_example/Debug"
+
+        configuration { "Release" }
+            objdir "obj/signal_slot_example/Release"
+            targetdir "bin/signal_slot_example/Release"
+
+        configuration "linux or macosx or bsd"
+            links { "pthread" }
+
+    project "signal_slot_benchmark"
+        files { "signal_slot_benchmark.cpp" }
+        configuration { "Debug" }
+            objdir "obj/signal_slot_benchmark/Debug"
+            targetdir "bin/signal_slot_benchmark/Debug"
+
+        configuration { "Release" }
+            objdir "obj/signal_slot_benchmark/Release"
+            targetdir "bin/signal_slot_benchmark/Release"
+
+        configuration "linux or macosx or bsd"
+            links { "pthread" }
+
+    project "thread_pool_benchmark"
+        files { "thread_pool_benchmark.cpp" }
+        configuration { "Debug" }
+            objdir "obj/thread_pool_benchmark/Debug"
+            targetdir "bin/thread_pool_benchmark/Debug"
+
+        configuration { "Release" }
+            objdir "obj/thread_pool_benchmark/Release"
+            targetdir "bin/thread_pool_benchmark/Release"
+
+        configuration "linux or macosx or bsd"
+            links { "pthread" }
+
+    project "thread_pool_example"
+        files { "thread_pool_example.cpp" }
+        configuration { "Debug" }
+            objdir "obj/thread_pool_example/Debug"
+            targetdir "bin/thread_pool_example/Debug"
+
+        configuration { "Release" }
+            objdir "obj/thread_pool_example/Release"
+            targetdir "bin/thread_pool_example/Release"
+
+        configuration "linux or macosx or bsd"
+            links { "pthread" }
+
     project "relinx_example"
         files { "relinx_example.cpp" }
         configuration { "Debug" }
@@ -19,10 +19,15 @@ SOFTWARE.
 */
 
 #include <any>
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <iomanip>
+#include <optional>
+#include <stdexcept>
 #include <typeinfo>
 #include <typeindex>
+#include <thread>
 #include <vector>
 #include "live_property.hpp"
 #include "json.hpp"
@@ -305,7 +310,185 @@ int main()
 
     qsss[u8"test"].emit("Hello Queued Scoped Signal Set!");
 
+    int failures { 0 };
+    auto check = [&failures](const char *what, bool passed)
+    {
+        std::cout << what << ": " << (passed ? "ok" : "FAILED") << std::endl;
+
+        if (!passed) ++failures;
+    };
+
+    {
+        std::cout << "...live_property_ts with a lock-free atomic value..." << std::endl;
+
+        static_assert(std::atomic<int>::is_always_lock_free);
+
+        nstd::live_property_ts<int> counter { u8"atomic counter"s };
+        std::atomic_int changing_count { 0 }, changed_count { 0 };
+
+        cons = counter.signal_value_changing.connect([&changing_count](auto &&) { ++changing_count; });
+        cons = counter.signal_value_changed.connect([&changed_count](auto &&) { ++changed_count; });
+
+        constexpr int thread_count { 4 }, increments { 1000 };
+        std::vector<std::thread> writers;
+
+        for (int thread = 0; thread < thread_count; ++thread) writers.emplace_back([&counter] { for (int step = 0; step < increments; ++step) ++counter; });
+        for (auto &&writer : writers) writer.join();
+
+        check("concurrent increments are not lost", counter.value() == thread_count * increments);
+        check("every increment is notified once", changing_count == thread_count * increments && changed_count == thread_count * increments);
+
+        counter = thread_count * increments;
+        counter += 0;
+
+        check("assigning the current value is not notified", changed_count == thread_count * increments);
+
+        cons = counter.signal_value_changing.connect([](auto &&ctx) { ctx.cancel = ctx.new_value < 0; });
+        counter = -1;
+
+        check("a cancelled change keeps the value", counter.value() == thread_count * increments && changed_count == thread_count * increments);
+    }
+
+    {
+        std::cout << "...live_property_ts with a sequence-locked value..." << std::endl;
+
+        struct rect { int64_t left, top, right, bottom; };
+
+        static_assert(!std::atomic<rect>::is_always_lock_free);
+
+        nstd::live_property_ts<rect> area { u8"seqlock rect"s };
+        std::atomic_int changed_count { 0 };
+        std::atomic_bool writing { true }, torn { false };
+
+        cons = area.signal_value_changed.connect([&changed_count](auto &&) { ++changed_count; });
+
+        constexpr int64_t writes { 20000 };
+        std::vector<std::thread> readers;
+
+        for (int thread = 0; thread < 2; ++thread) readers.emplace_back([&area, &writing, &torn]
+        {
+            while (writing)
+            {
+                auto value { area.value() };
+
+                if (value.top != value.left || value.right != value.left || value.bottom != value.left) torn = true;
+            }
+        });
+
+        for (int64_t step = 1; step <= writes; ++step) area = rect { step, step, step, step };
+
+        writing = false;
+
+        for (auto &&reader : readers) reader.join();
+
+        check("readers never see a torn value", !torn);
+        check("every write is notified once", changed_count == writes && area.value().bottom == writes);
+
+        area = rect { writes, writes, writes, writes };
+
+        check("assigning an equal value is not notified", changed_count == writes);
+
+        nstd::live_property_ts<rect> copy { area };
+
+        check("a copy reads the same value", copy.value().left == writes);
+    }
+
+    {
+        std::cout << "...live_property_transaction..." << std::endl;
+
+        live_int width { u8"width"s }, height { u8"height"s };
+        std::vector<std::string> changes;
+
+        auto record = [&changes](auto &&property) { changes.push_back(std::string { property.name().begin(), property.name().end() } + "=" + std::to_string(property.value())); };
+
+        cons = width.signal_value_changed.connect(record);
+        cons = height.signal_value_changed.connect(record);
+
+        {
+            nstd::live_property_transaction transaction;
+
+            height = 1;
+            width = 1;
+            width = 2;
+            width += 1;
+
+            check("staged writes are read back but not notified", width.value() == 3 && std::empty(changes));
+        }
+
+        check("a commit notifies once per property in write order", changes == std::vector<std::string> { "height=1", "width=3" });
+
+        changes.clear();
+
+        {
+            nstd::live_property_transaction transaction;
+
+            width = 10;
+            width = 3;
+        }
+
+        check("writing the old value back is not notified", std::empty(changes) && width.value() == 3);
+
+        try
+        {
+            nstd::live_property_transaction transaction;
+
+            width = 20;
+
+            throw std::runtime_error { "leaving the transaction" };
+        }
+        catch (const std::runtime_error &) {}
+
+        check("an exception rolls the transaction back", width.value() == 3 && std::empty(changes));
+
+        {
+            nstd::live_property_transaction outer;
+
+            width = 4;
+
+            {
+                nstd::live_property_transaction inner;
+
+                height = 5;
+            }
+
+            check("a nested transaction joins the outer one", std::empty(changes) && nstd::live_property_transaction::current() == &outer);
+
+            width = 6;
+        }
+
+        check("the outer transaction commits the nested writes", changes == std::vector<std::string> { "width=6", "height=5" });
+        check("no transaction is active after commit", nstd::live_property_transaction::current() == nullptr);
+
+        changes.clear();
+
+        {
+            ss::connection veto { width.signal_value_changing.connect([](auto &&ctx) { ctx.cancel = ctx.new_value > 100; }) };
+            nstd::live_property_transaction transaction;
+
+            width = 200;
+            height = 7;
+        }
+
+        check("a change cancelled during commit keeps the value", width.value() == 6 && height.value() == 7 && changes == std::vector<std::string> { "height=7" });
+
+        changes.clear();
+
+        {
+            std::optional<live_int> temporary { std::in_place, u8"temporary"s };
+
+            cons = temporary->signal_value_changed.connect(record);
+
+            nstd::live_property_transaction transaction;
+
+            *temporary = 8;
+            height = 9;
+            temporary.reset();
+        }
+
+        check("a property destroyed while staged is skipped", changes == std::vector<std::string> { "height=9" });
+    }
+
     std::cout << "exitting..." << std::endl;
 
-    return 0;
+    return failures == 0 ? 0 : 1;
 }
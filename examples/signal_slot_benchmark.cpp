@@ -0,0 +1,388 @@
+/*
+MIT License
+Copyright (c) 2017 Arlen Keshabyan (arlen.albert@gmail.com)
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "signal_slot.hpp"
+#include "benchmark_results.hpp"
+
+namespace ss = nstd::signal_slot;
+
+using namespace std::chrono_literals;
+using clock_type = std::chrono::steady_clock;
+
+int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+template<typename signal_type>
+void emit_across_slot_counts(benchmark_results &results, std::string_view variant)
+{
+    constexpr size_t latency_samples { 20'000 };
+
+    for (size_t slot_count : { 0, 1, 4, 16, 64, 256 })
+    {
+        signal_type sig;
+        ss::connection_bag cons;
+        uint64_t counter { 0 };
+
+        for (size_t i = 0; i < slot_count; ++i) cons = sig.connect([&counter](int v){ counter += v; });
+
+        const size_t emit_count { std::max<size_t>(2'000'000 / (slot_count + 1), 20'000) };
+        const auto parameter { "slots=" + std::to_string(slot_count) };
+
+        sig.emit(0);
+
+        auto begin { clock_type::now() };
+
+        for (size_t i = 0; i < emit_count; ++i) sig.emit(1);
+
+        std::chrono::duration<double> elapsed { clock_type::now() - begin };
+        ss::latency_histogram latency;
+
+        for (size_t i = 0; i < latency_samples; ++i)
+        {
+            auto start { now_ns() };
+
+            sig.emit(1);
+
+            latency.record(static_cast<uint64_t>(now_ns() - start));
+        }
+
+        const auto throughput { static_cast<double>(emit_count) / elapsed.count() };
+
+        results.add("emit", variant, parameter, "throughput", throughput, "emits/s");
+        results.add("emit", variant, parameter, "slot_calls", throughput * static_cast<double>(slot_count), "calls/s");
+        results.add_latency("emit", variant, parameter, latency);
+
+        std::cout << std::left << std::setw(20) << variant << std::setw(12) << parameter << std::right << std::fixed << std::setprecision(0)
+                  << std::setw(16) << throughput << std::setw(12) << latency.percentile(50) << std::setw(12) << latency.percentile(99) << std::endl;
+    }
+}
+
+void benchmark_emit(benchmark_results &results)
+{
+    std::cout << "=== Emit throughput and latency across slot counts ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "signal" << std::setw(12) << "slots" << std::right << std::setw(16) << "emits/s" << std::setw(12) << "p50 (ns)" << std::setw(12) << "p99 (ns)" << std::endl;
+
+    emit_across_slot_counts<ss::signal<int>>(results, "signal");
+    emit_across_slot_counts<ss::concurrent_signal<int>>(results, "concurrent_signal");
+    emit_across_slot_counts<ss::instrumented_signal<int>>(results, "instrumented_signal");
+}
+
+template<typename signal_type>
+void connect_churn(benchmark_results &results, std::string_view variant)
+{
+    constexpr size_t churn_count { 200'000 };
+
+    for (size_t slot_count : { 0, 64 })
+    {
+        for (bool emitting : { false, true })
+        {
+            signal_type sig;
+            ss::connection_bag cons;
+            uint64_t counter { 0 };
+
+            for (size_t i = 0; i < slot_count; ++i) cons = sig.connect([&counter](int v){ counter += v; });
+
+            auto begin { clock_type::now() };
+
+            for (size_t i = 0; i < churn_count; ++i)
+            {
+                auto c { sig.connect([&counter](int v){ counter += v; }) };
+
+                if (emitting) sig.emit(1);
+            }
+
+            std::chrono::duration<double> elapsed { clock_type::now() - begin };
+
+            const auto parameter { "slots=" + std::to_string(slot_count) + (emitting ? ";emit=1" : ";emit=0") };
+            const auto rate { static_cast<double>(churn_count) / elapsed.count() };
+
+            results.add("connect_churn", variant, parameter, "throughput", rate, "connect_disconnect/s");
+
+            std::cout << std::left << std::setw(20) << variant << std::setw(20) << parameter << std::right << std::fixed << std::setprecision(0) << std::setw(22) << rate << std::endl;
+        }
+    }
+}
+
+void benchmark_connect_churn(benchmark_results &results)
+{
+    std::cout << "=== Connect/disconnect churn ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "signal" << std::setw(20) << "parameters" << std::right << std::setw(22) << "connect+disconnect/s" << std::endl;
+
+    connect_churn<ss::signal<int>>(results, "signal");
+    connect_churn<ss::concurrent_signal<int>>(results, "concurrent_signal");
+}
+
+template<typename signal_type>
+double contended_emit_throughput(size_t thread_count, size_t slot_count, size_t emits_per_thread)
+{
+    signal_type sig;
+    ss::connection_bag cons;
+    std::atomic_uint64_t counter { 0 };
+
+    for (size_t i = 0; i < slot_count; ++i) cons = sig.connect([&counter](int v){ counter.fetch_add(v, std::memory_order_relaxed); });
+
+    std::atomic_bool start { false };
+    std::vector<std::jthread> threads;
+
+    for (size_t t = 0; t < thread_count; ++t)
+    {
+        threads.emplace_back([&sig, &start, emits_per_thread]
+        {
+            while (!start.load(std::memory_order_acquire)) std::this_thread::yield();
+
+            for (size_t i = 0; i < emits_per_thread; ++i) sig.emit(1);
+        });
+    }
+
+    auto begin { clock_type::now() };
+
+    start.store(true, std::memory_order_release);
+
+    threads.clear();
+
+    std::chrono::duration<double> elapsed { clock_type::now() - begin };
+
+    return static_cast<double>(thread_count * emits_per_thread) / elapsed.count();
+}
+
+void benchmark_contended_emit(benchmark_results &results)
+{
+    constexpr size_t slot_count { 8 }, emits_per_thread { 200'000 };
+    const size_t max_threads { std::max<size_t>(std::thread::hardware_concurrency(), 4) };
+
+    std::cout << "=== Contended emit throughput (" << slot_count << " slots, " << emits_per_thread << " emits per thread) ===" << std::endl;
+    std::cout << std::left << std::setw(10) << "threads" << std::right << std::setw(22) << "signal (emits/s)" << std::setw(30) << "concurrent_signal (emits/s)" << std::endl;
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2)
+    {
+        auto locked { contended_emit_throughput<ss::signal<int>>(threads, slot_count, emits_per_thread) };
+        auto cow { contended_emit_throughput<ss::concurrent_signal<int>>(threads, slot_count, emits_per_thread) };
+        const auto parameter { "threads=" + std::to_string(threads) + ";slots=" + std::to_string(slot_count) };
+
+        results.add("contended_emit", "signal", parameter, "throughput", locked, "emits/s");
+        results.add("contended_emit", "concurrent_signal", parameter, "throughput", cow, "emits/s");
+
+        std::cout << std::left << std::setw(10) << threads << std::right << std::fixed << std::setprecision(0) << std::setw(22) << locked << std::setw(30) << cow << std::endl;
+    }
+}
+
+/**
+ * @brief Measures the time from emitting a deferred signal to the invocation of its slot
+ *
+ * Emissions are made one at a time, each after the previous one has been delivered, so
+ * the samples do not include queueing behind other emissions.
+ *
+ * @param sig The signal, carrying the emission time in nanoseconds
+ * @param latency The histogram receiving the samples
+ * @param samples Number of emissions
+ * @param pump Called after every emission to deliver it, if the signal needs it
+ */
+template<typename signal_type, typename Pump>
+void dispatch_latency(signal_type &sig, ss::latency_histogram &latency, size_t samples, Pump &&pump)
+{
+    std::atomic_uint64_t delivered { 0 };
+
+    auto c { sig.connect([&latency, &delivered](int64_t emitted){ latency.record(static_cast<uint64_t>(now_ns() - emitted)); delivered.fetch_add(1, std::memory_order_release); delivered.notify_one(); }) };
+
+    for (uint64_t i = 0; i < samples; ++i)
+    {
+        sig.emit(now_ns());
+        pump();
+
+        for (auto seen { delivered.load(std::memory_order_acquire) }; seen <= i; seen = delivered.load(std::memory_order_acquire)) delivered.wait(seen, std::memory_order_acquire);
+    }
+}
+
+void benchmark_dispatch_latency(benchmark_results &results)
+{
+    constexpr size_t samples { 2'000 };
+
+    std::cout << "=== Deferred dispatch latency (" << samples << " emissions, emit to slot) ===" << std::endl;
+    std::cout << std::left << std::setw(34) << "signal" << std::right << std::setw(12) << "p50 (ns)" << std::setw(12) << "p99 (ns)" << std::setw(14) << "max (ns)" << std::endl;
+
+    auto report { [&results](std::string_view variant, const ss::latency_histogram &latency)
+    {
+        results.add_latency("dispatch_latency", variant, "samples=" + std::to_string(samples), latency);
+
+        std::cout << std::left << std::setw(34) << variant << std::right << std::setw(12) << latency.percentile(50) << std::setw(12) << latency.percentile(99) << std::setw(14) << latency.max() << std::endl;
+    } };
+
+    {
+        ss::bridged_signal<int64_t> sig { u8"bridged", [](auto*){ return true; } };
+        ss::latency_histogram latency;
+
+        dispatch_latency(sig, latency, samples, [&sig]{ sig.invoke_all(); });
+        report("bridged_signal (invoke_all)", latency);
+    }
+
+    {
+        std::atomic_uint64_t pending { 0 };
+        ss::bridged_signal<int64_t> sig { u8"bridged", [&pending](auto*){ pending.fetch_add(1); pending.notify_one(); return true; } };
+        std::jthread consumer { [&sig, &pending](std::stop_token stop)
+        {
+            for (uint64_t handled { 0 }; !stop.stop_requested();)
+            {
+                pending.wait(handled);
+                handled = pending.load();
+                sig.invoke_all();
+            }
+        } };
+
+        ss::latency_histogram latency;
+
+        dispatch_latency(sig, latency, samples, []{});
+        report("bridged_signal (consumer thread)", latency);
+
+        consumer.request_stop();
+        pending.fetch_add(1);
+        pending.notify_one();
+    }
+
+    {
+        ss::throttled_signal<int64_t> sig { u8"throttled", 0ms };
+        ss::latency_histogram latency;
+
+        dispatch_latency(sig, latency, samples, []{});
+        report("throttled_signal (0ms)", latency);
+    }
+
+    {
+        ss::queued_signal<int64_t> sig;
+        ss::latency_histogram latency;
+
+        dispatch_latency(sig, latency, samples, []{});
+        report("queued_signal", latency);
+    }
+}
+
+size_t process_thread_count()
+{
+#ifdef __linux__
+    std::ifstream status { "/proc/self/status" };
+
+    for (std::string line; std::getline(status, line);)
+        if (line.starts_with("Threads:")) return std::stoul(line.substr(8));
+#endif
+    return 0;
+}
+
+void benchmark_throttled_jitter(benchmark_results &results)
+{
+    constexpr size_t signal_count { 1'000 }, emits_per_signal { 20 };
+    constexpr auto throttle { 5ms };
+
+    std::vector<std::unique_ptr<ss::throttled_signal<int>>> signals;
+    std::vector<std::vector<clock_type::time_point>> deliveries(signal_count);
+    ss::connection_bag cons;
+
+    for (size_t i = 0; i < signal_count; ++i)
+    {
+        auto &sig { signals.emplace_back(std::make_unique<ss::throttled_signal<int>>(u8"throttled", throttle)) };
+
+        deliveries[i].reserve(emits_per_signal);
+
+        cons = sig->connect([&times = deliveries[i]](int){ times.push_back(clock_type::now()); });
+    }
+
+    const auto threads_before { process_thread_count() };
+
+    for (size_t e = 0; e < emits_per_signal; ++e) for (auto &sig : signals) sig->emit(static_cast<int>(e));
+
+    const auto threads_during { process_thread_count() };
+
+    std::this_thread::sleep_for(throttle * emits_per_signal + 500ms);
+
+    signals.clear();
+
+    std::vector<double> jitter_us;
+
+    for (auto &times : deliveries)
+        for (size_t i = 1; i < std::size(times); ++i)
+            jitter_us.push_back(std::abs(std::chrono::duration<double, std::micro>(times[i] - times[i - 1] - throttle).count()));
+
+    std::sort(std::begin(jitter_us), std::end(jitter_us));
+
+    auto percentile { [&jitter_us](double p){ return std::empty(jitter_us) ? 0.0 : jitter_us[static_cast<size_t>(p * (std::size(jitter_us) - 1))]; } };
+    const auto parameter { "signals=" + std::to_string(signal_count) + ";throttle_ms=" + std::to_string(throttle.count()) };
+
+    results.add("throttled_jitter", "throttled_signal", parameter, "jitter_p50", percentile(0.5), "us");
+    results.add("throttled_jitter", "throttled_signal", parameter, "jitter_p99", percentile(0.99), "us");
+    results.add("throttled_jitter", "throttled_signal", parameter, "jitter_max", percentile(1.0), "us");
+    results.add("throttled_jitter", "throttled_signal", parameter, "process_threads", static_cast<double>(threads_during), "threads");
+
+    std::cout << "=== Throttled delivery jitter (" << signal_count << " signals, " << emits_per_signal << " emits each, " << throttle.count() << "ms throttle) ===" << std::endl;
+    std::cout << "timer wheel dispatchers: " << ss::timer_wheel::global().dispatcher_count() << std::endl;
+    std::cout << "process threads before emit: " << threads_before << ", while dispatching: " << threads_during << std::endl;
+    std::cout << std::fixed << std::setprecision(1) << "jitter (us): p50 " << percentile(0.5) << ", p99 " << percentile(0.99) << ", max " << percentile(1.0) << std::endl;
+}
+
+/**
+ * Usage: signal_slot_benchmark [--json=<file>] [--csv=<file>] [--label=<text>]
+ *
+ * The tables are always printed; the options additionally write all measurements in a
+ * machine-readable form, tagged with the label (e.g. a version or a commit), so that runs
+ * can be compared to track regressions.
+ */
+int main(int argc, char *argv[])
+{
+    std::string json_path, csv_path, label { "signal_slot" };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg { argv[i] };
+
+        if (arg.starts_with("--json=")) json_path = arg.substr(7);
+        else if (arg.starts_with("--csv=")) csv_path = arg.substr(6);
+        else if (arg.starts_with("--label=")) label = arg.substr(8);
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--json=<file>] [--csv=<file>] [--label=<text>]" << std::endl;
+
+            return 1;
+        }
+    }
+
+    benchmark_results results;
+
+    benchmark_emit(results);
+    benchmark_connect_churn(results);
+    benchmark_contended_emit(results);
+    benchmark_dispatch_latency(results);
+    benchmark_throttled_jitter(results);
+
+    if (!std::empty(json_path)) std::ofstream { json_path } << results.to_json(label);
+    if (!std::empty(csv_path)) std::ofstream { csv_path } << results.to_csv(label);
+
+    return 0;
+}
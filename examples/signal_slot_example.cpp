@@ -0,0 +1,1346 @@
+/*
+MIT License
+Copyright (c) 2017 Arlen Keshabyan (arlen.albert@gmail.com)
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "signal_slot.hpp"
+#include "thread_pool.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <coroutine>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+using namespace std::literals;
+
+static thread_local size_t allocations { 0 };
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+
+    if (auto memory { std::malloc(size ? size : 1) }) return memory;
+
+    throw std::bad_alloc {};
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    ++allocations;
+
+    return std::malloc(size ? size : 1);
+}
+
+[[gnu::noinline]] void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    ::operator delete(memory);
+}
+
+struct payload
+{
+    static inline std::atomic_int copies { 0 };
+
+    std::vector<int> data {};
+
+    payload(std::vector<int> d) : data { std::move(d) } {}
+    payload(const payload &other) : data { other.data } { ++copies; }
+    payload(payload &&other) noexcept = default;
+    payload &operator=(const payload &other) { data = other.data; ++copies; return *this; }
+    payload &operator=(payload &&other) noexcept = default;
+};
+
+struct awaiting_task
+{
+    struct promise_type
+    {
+        awaiting_task get_return_object() noexcept { return awaiting_task { std::coroutine_handle<promise_type>::from_promise(*this) }; }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() { std::terminate(); }
+    };
+
+    std::coroutine_handle<promise_type> handle {};
+
+    explicit awaiting_task(std::coroutine_handle<promise_type> h) noexcept : handle { h } {}
+    awaiting_task(awaiting_task &&other) noexcept : handle { std::exchange(other.handle, {}) } {}
+    awaiting_task &operator=(awaiting_task &&other) = delete;
+    ~awaiting_task() { if (handle) handle.destroy(); }
+
+    bool done() const noexcept { return handle.done(); }
+};
+
+template<typename Source>
+awaiting_task collect(Source &source, std::vector<std::string> &received, int count)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        auto value { co_await source.next() };
+
+        if (!value)
+        {
+            received.push_back("end");
+
+            co_return;
+        }
+
+        received.push_back(std::to_string(std::get<0>(*value)) + std::get<1>(*value));
+    }
+}
+
+template<typename Predicate>
+bool wait_for(Predicate &&predicate)
+{
+    for (auto deadline { std::chrono::steady_clock::now() + 5s }; !predicate(); std::this_thread::sleep_for(1ms))
+        if (std::chrono::steady_clock::now() > deadline) return false;
+
+    return true;
+}
+
+TEST_CASE("connecting and emitting reuse the slot storage", "[signal_slot]")
+{
+    nstd::signal_slot::signal<int> s;
+    std::vector<nstd::signal_slot::connection> connections;
+    int total { 0 };
+
+    auto connect_all { [&]
+    {
+        for (int i = 0; i < 64; ++i) connections.push_back(s.connect([&total, i](int value){ total += value * i; }, i % 4));
+    } };
+
+    auto reconnect_last { [&]
+    {
+        connections.back().disconnect();
+        connections.back() = s.connect([&total](int value){ total += value; }, 2);
+        s.emit(1);
+    } };
+
+    connections.reserve(64);
+    connect_all();
+    s.emit(1);
+    connections.clear();
+    s.emit(1);
+
+    CHECK(s.size() == 0);
+
+    auto before { allocations };
+
+    connect_all();
+
+    CHECK(allocations == before);
+
+    s.emit(1);
+    reconnect_last();
+    before = allocations;
+    s.emit(1);
+    reconnect_last();
+
+    CHECK(allocations == before);
+    CHECK(s.size() == 64);
+    CHECK(total == 2 * 2016 + 3 * (2016 - 63 + 1));
+}
+
+TEST_CASE("connections are disconnected while other threads connect and emit", "[signal_slot]")
+{
+    nstd::signal_slot::signal<int> s;
+    std::atomic_int total { 0 };
+    std::atomic_bool done { false };
+    std::mutex connections_lock;
+    std::vector<nstd::signal_slot::connection> connections;
+
+    {
+        std::jthread emitter { [&]{ while (!done) s.emit(1); } };
+        std::jthread disconnector { [&]
+        {
+            while (!done)
+            {
+                std::scoped_lock lock { connections_lock };
+
+                if (!std::empty(connections)) connections.erase(std::begin(connections));
+            }
+        } };
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            auto c { s.connect([&total](int value){ total += value; }, i % 8) };
+
+            std::scoped_lock lock { connections_lock };
+
+            connections.push_back(std::move(c));
+        }
+
+        done = true;
+    }
+
+    connections.clear();
+    s.emit(1);
+
+    CHECK(s.size() == 0);
+}
+
+TEST_CASE("slot handles are checked against their generation", "[signal_slot]")
+{
+    nstd::signal_slot::signal<int> s;
+    std::vector<int> calls;
+
+    auto index_of { [](nstd::signal_slot::slot_id id){ return static_cast<uint64_t>(id) & 0xffffffff; } };
+
+    SECTION("a stale handle does not reach the slot reusing its index")
+    {
+        auto first { s.connect([&calls](int){ calls.push_back(1); }) };
+        auto stale { first.id() };
+
+        first.disconnect();
+        s.emit(0);
+
+        auto second { s.connect([&calls](int){ calls.push_back(2); }) };
+
+        CHECK(index_of(second.id()) == index_of(stale));
+        CHECK(second.id() != stale);
+        CHECK_FALSE(s.is_slot_enabled(stale));
+        CHECK_FALSE(s.set_connection_priority(stale, 3));
+
+        s.enable_slot(stale, false);
+        s.emit(0);
+
+        CHECK(s.is_slot_enabled(second.id()));
+        CHECK(second.get_connection_priority() == 0);
+        CHECK(calls == std::vector<int> { 2 });
+    }
+
+    SECTION("slots are enabled and disconnected by handle")
+    {
+        auto first { s.connect([&calls](int){ calls.push_back(1); }) };
+        auto second { s.connect([&calls](int){ calls.push_back(2); }) };
+        auto second_id { second.id() };
+
+        s.enable_slot(first.id(), false);
+
+        CHECK_FALSE(s.is_slot_enabled(first.id()));
+        CHECK_FALSE(first.is_enabled());
+
+        s.emit(0);
+        first.set_enabled(true);
+        s.emit(0);
+        second.disconnect();
+        s.emit(0);
+
+        CHECK(calls == std::vector<int> { 2, 1, 2, 1 });
+        CHECK_FALSE(s.is_slot_enabled(second_id));
+        CHECK(s.size() == 1);
+
+        s.enable_slot(second_id, true);
+        s.emit(0);
+
+        CHECK(calls == std::vector<int> { 2, 1, 2, 1, 1 });
+    }
+
+    SECTION("priority changes reposition slots before the next emission")
+    {
+        auto first { s.connect([&calls](int){ calls.push_back(1); }, 0) };
+        auto second { s.connect([&calls](int){ calls.push_back(2); }, 1) };
+        auto third { s.connect([&calls](int){ calls.push_back(3); }, 2) };
+
+        s.emit(0);
+
+        CHECK(s.set_connection_priority(first.id(), 5));
+        CHECK(third.set_connection_priority(-1));
+        CHECK(first.get_connection_priority() == 5);
+
+        s.emit(0);
+        second.set_connection_priority(6);
+        s.emit(0);
+
+        CHECK(calls == std::vector<int> { 1, 2, 3, 3, 2, 1, 3, 1, 2 });
+    }
+}
+
+TEST_CASE("concurrent signals emit from the snapshot taken when the emission started", "[signal_slot]")
+{
+    nstd::signal_slot::concurrent_signal<int> s;
+
+    SECTION("slots connected or disconnected during an emission")
+    {
+        std::vector<int> calls;
+        std::atomic_bool entered { false }, proceed { false };
+        nstd::signal_slot::connection late;
+
+        auto first { s.connect([&](int){ calls.push_back(1); entered = true; while (!proceed) std::this_thread::yield(); }) };
+        auto second { s.connect([&calls](int){ calls.push_back(2); }) };
+
+        {
+            std::jthread emitter { [&s]{ s.emit(0); } };
+
+            while (!entered) std::this_thread::yield();
+
+            late = s.connect([&calls](int){ calls.push_back(3); });
+            second.disconnect();
+            proceed = true;
+        }
+
+        CHECK(calls == std::vector<int> { 1 });
+        CHECK(s.size() == 2);
+
+        calls.clear();
+        s.emit(0);
+
+        CHECK(calls == std::vector<int> { 1, 3 });
+    }
+
+    SECTION("slots disconnected by an earlier slot of the same emission")
+    {
+        std::vector<int> calls;
+        nstd::signal_slot::connection second, late;
+
+        auto first { s.connect([&](int){ calls.push_back(1); second.disconnect(); late = s.connect([&calls](int){ calls.push_back(3); }); }) };
+
+        second = s.connect([&calls](int){ calls.push_back(2); });
+        s.emit(0);
+
+        CHECK(calls == std::vector<int> { 1 });
+        CHECK(s.size() == 2);
+    }
+
+    SECTION("disconnected slots are pruned by the next emission")
+    {
+        int total { 0 };
+        std::vector<nstd::signal_slot::connection> connections;
+
+        for (int i = 0; i < 8; ++i) connections.push_back(s.connect([&total](int value){ total += value; }));
+
+        connections.resize(3);
+
+        CHECK(s.size() == 8);
+
+        s.emit(1);
+
+        CHECK(total == 3);
+        CHECK(s.size() == 3);
+
+        connections.clear();
+        s.emit(1);
+
+        CHECK(total == 3);
+        CHECK(s.size() == 0);
+    }
+
+    SECTION("connections change while other threads emit")
+    {
+        constexpr int emitter_count { 3 };
+        std::atomic_int persistent_calls { 0 }, emissions { 0 };
+        std::atomic_bool done { false };
+
+        auto persistent { s.connect([&persistent_calls](int){ ++persistent_calls; }) };
+
+        {
+            std::vector<std::jthread> emitters;
+
+            for (int i = 0; i < emitter_count; ++i) emitters.emplace_back([&]{ while (!done) s.emit(1), ++emissions; });
+
+            std::vector<nstd::signal_slot::connection> connections;
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                connections.push_back(s.connect([](int){}, i % 8));
+
+                if (i % 3 == 0) connections.erase(std::begin(connections));
+            }
+
+            connections.clear();
+            done = true;
+        }
+
+        CHECK(persistent_calls == emissions);
+
+        s.emit(1);
+
+        CHECK(s.size() == 1);
+    }
+}
+
+TEST_CASE("batch emissions reach batch-aware slots once and other slots per item", "[signal_slot]")
+{
+    using item_type = std::tuple<int, std::string>;
+
+    std::vector<item_type> batch { { 1, "a" }, { 2, "b" }, { 3, "c" } };
+    std::vector<std::string> calls;
+
+    auto emit_all { [&](auto &s)
+    {
+        auto items { s.connect([&calls](int value, const std::string &text){ calls.push_back("item " + std::to_string(value) + text); }, 1) };
+        auto whole { s.connect_batch([&calls](std::span<const item_type> items){ calls.push_back("batch " + std::to_string(std::size(items))); }, 0) };
+        auto last { s.connect([&calls](int value, const std::string &){ calls.push_back("last " + std::to_string(value)); }, 2) };
+
+        s.emit_batch(batch);
+        s.emit_batch(std::span<const item_type> {});
+
+        CHECK(calls == std::vector<std::string> { "batch 3", "item 1a", "item 2b", "item 3c", "last 1", "last 2", "last 3" });
+
+        calls.clear();
+        s.emit(4, "d");
+
+        CHECK(calls == std::vector<std::string> { "batch 1", "item 4d", "last 4" });
+    } };
+
+    SECTION("signal")
+    {
+        nstd::signal_slot::signal<int, std::string> s;
+
+        emit_all(s);
+    }
+
+    SECTION("concurrent_signal")
+    {
+        nstd::signal_slot::concurrent_signal<int, std::string> s;
+
+        emit_all(s);
+    }
+}
+
+TEST_CASE("emit_async runs slots by their affinity and completes its handle", "[signal_slot]")
+{
+    using nstd::signal_slot::slot_affinity;
+
+    std::mutex tasks_lock;
+    std::deque<nstd::signal_slot::async_task> tasks;
+    std::vector<std::string> calls;
+    std::thread::id executor_thread {};
+
+    nstd::signal_slot::executor_type executor { [&](nstd::signal_slot::async_task &&task){ std::scoped_lock lock(tasks_lock); tasks.push_back(std::move(task)); } };
+
+    auto run_tasks { [&]
+    {
+        while (true)
+        {
+            nstd::signal_slot::async_task task;
+
+            {
+                std::scoped_lock lock(tasks_lock);
+
+                if (std::empty(tasks)) return;
+
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+
+            task();
+        }
+    } };
+
+    auto starting_with { [&calls](const std::string &prefix)
+    {
+        std::vector<std::string> result;
+
+        for (auto &call : calls) if (call.starts_with(prefix)) result.push_back(call);
+
+        return result;
+    } };
+
+    auto emit_all { [&](auto &s)
+    {
+        nstd::signal_slot::strand serial { executor };
+
+        s.set_executor(executor);
+
+        auto caller { s.connect([&calls](int v){ calls.push_back("caller " + std::to_string(v)); }) };
+        auto on_executor { s.connect([&](int v){ calls.push_back("executor " + std::to_string(v)); executor_thread = std::this_thread::get_id(); }, slot_affinity::executor) };
+        auto first { s.connect([&calls](int v){ calls.push_back("strand a" + std::to_string(v)); }, serial, 1) };
+        auto second { s.connect([&calls](int v){ calls.push_back("strand b" + std::to_string(v)); }, serial, 2) };
+
+        auto emission1 { s.emit_async(1) };
+        auto emission2 { s.emit_async(2) };
+
+        CHECK(calls == std::vector<std::string> { "caller 1", "caller 2" });
+        CHECK_FALSE(emission1.done());
+        CHECK_FALSE(emission2.done());
+
+        std::jthread runner { run_tasks };
+        auto runner_thread { runner.get_id() };
+
+        runner.join();
+
+        CHECK(emission1.done());
+        CHECK(emission2.done());
+        CHECK(executor_thread == runner_thread);
+        CHECK(starting_with("executor") == std::vector<std::string> { "executor 1", "executor 2" });
+        CHECK(starting_with("strand") == std::vector<std::string> { "strand a1", "strand b1", "strand a2", "strand b2" });
+
+        calls.clear();
+
+        auto failing { s.connect([](int v){ if (v == 3) throw std::runtime_error("slot failed"); }, slot_affinity::executor) };
+        auto emission3 { s.emit_async(3) };
+
+        run_tasks();
+
+        CHECK_THROWS_AS(emission3.wait(), std::runtime_error);
+        CHECK(starting_with("executor") == std::vector<std::string> { "executor 3" });
+        CHECK(starting_with("strand") == std::vector<std::string> { "strand a3", "strand b3" });
+
+        calls.clear();
+
+        auto emission4 { s.emit_async(4) };
+
+        std::jthread delayed { [&]{ std::this_thread::sleep_for(20ms); run_tasks(); } };
+
+        emission4.wait();
+
+        CHECK(emission4.done());
+        CHECK(std::size(calls) == 4);
+    } };
+
+    SECTION("signal")
+    {
+        nstd::signal_slot::signal<int> s;
+
+        emit_all(s);
+    }
+
+    SECTION("concurrent_signal")
+    {
+        nstd::signal_slot::concurrent_signal<int> s;
+
+        emit_all(s);
+    }
+}
+
+TEST_CASE("coroutines await the emissions of signals and streams", "[signal_slot]")
+{
+    using strings = std::vector<std::string>;
+
+    strings received, abandoned;
+
+    SECTION("next")
+    {
+        nstd::signal_slot::signal<int, std::string> s;
+
+        auto task { collect(s, received, 2) };
+
+        CHECK(std::empty(received));
+
+        s.emit(1, "a");
+
+        CHECK(received == strings { "1a" });
+
+        s.emit(2, "b");
+        s.emit(3, "c");
+
+        CHECK(received == strings { "1a", "2b" });
+        CHECK(task.done());
+
+        std::optional<nstd::signal_slot::signal<int, std::string>> ending { std::in_place };
+        auto ended { collect(*ending, received, 1) };
+
+        ending.reset();
+
+        CHECK(received == strings { "1a", "2b", "end" });
+        CHECK(ended.done());
+    }
+
+    SECTION("destroying a waiting coroutine")
+    {
+        nstd::signal_slot::signal<int, std::string> s;
+
+        std::optional<awaiting_task> first { collect(s, abandoned, 1) };
+        auto second { collect(s, received, 1) };
+
+        first.reset();
+        s.emit(1, "a");
+
+        CHECK(std::empty(abandoned));
+        CHECK(received == strings { "1a" });
+        CHECK(second.done());
+
+        first.emplace(collect(s, abandoned, 1));
+        first.reset();
+        s.emit(2, "b");
+
+        CHECK(std::empty(abandoned));
+    }
+
+    SECTION("emission_stream")
+    {
+        nstd::signal_slot::signal<int, std::string> s;
+        nstd::signal_slot::emission_stream<int, std::string> stream { s };
+        nstd::signal_slot::emission_stream<int, std::string> bounded { s, 2, nstd::signal_slot::overflow_policy::drop_oldest };
+
+        s.emit(1, "a");
+        s.emit(2, "b");
+        s.emit(3, "c");
+
+        CHECK(stream.size() == 3);
+        CHECK(bounded.size() == 2);
+        CHECK(bounded.get_dropped_count() == 1);
+
+        auto task { collect(stream, received, 4) };
+
+        CHECK(received == strings { "1a", "2b", "3c" });
+        CHECK(stream.size() == 0);
+        CHECK_FALSE(task.done());
+
+        s.emit(4, "d");
+
+        CHECK(received == strings { "1a", "2b", "3c", "4d" });
+        CHECK(stream.size() == 0);
+        CHECK(task.done());
+
+        std::optional<awaiting_task> waiting { collect(stream, abandoned, 1) };
+
+        waiting.reset();
+        s.emit(5, "e");
+
+        CHECK(std::empty(abandoned));
+        CHECK(stream.try_next() == std::tuple { 5, "e"s });
+
+        auto from_bounded { collect(bounded, received, 4) };
+
+        CHECK(received == strings { "1a", "2b", "3c", "4d", "4d", "5e" });
+        CHECK(bounded.get_dropped_count() == 3);
+
+        bounded.close();
+
+        CHECK(received == strings { "1a", "2b", "3c", "4d", "4d", "5e", "end" });
+        CHECK(from_bounded.done());
+    }
+}
+
+TEST_CASE("std::function connections are dispatched to overrides", "[signal_slot]")
+{
+    struct counting_signal : nstd::signal_slot::signal<int>
+    {
+        int connects { 0 };
+
+        nstd::signal_slot::connection connect(std::function<void(int)> &&callable, int64_t priority = 0) override
+        {
+            ++connects;
+
+            return nstd::signal_slot::signal<int>::connect(std::move(callable), priority);
+        }
+    };
+
+    counting_signal derived;
+    nstd::signal_slot::signal<int> &s { derived };
+    int total { 0 };
+
+    auto c1 { s.connect(std::function<void(int)> { [&total](int value){ total += value; } }) };
+    auto c2 { s += std::function<void(int)> { [&total](int value){ total += value; } } };
+    auto c3 { s.connect([&total](int value){ total += value; }) };
+
+    s.emit(2);
+
+    CHECK(derived.connects == 2);
+    CHECK(total == 6);
+}
+
+TEST_CASE("rvalue emit moves the payload into the last slot", "[signal_slot]")
+{
+    nstd::signal_slot::signal<payload> s;
+    size_t received { 0 };
+
+    auto c1 { s.connect([&received](const payload &p){ received += std::size(p.data); }, 0) };
+    auto c2 { s.connect([&received](payload &&p){ payload owned { std::move(p) }; received += std::size(owned.data); }, 1) };
+
+    payload::copies = 0;
+
+    s.emit(payload { { 1, 2, 3 } });
+
+    CHECK(received == 6);
+    CHECK(payload::copies == 0);
+
+    SECTION("a consuming slot that is not the last one gets a copy")
+    {
+        c2.set_connection_priority(-1);
+
+        s.emit(payload { { 1, 2, 3 } });
+
+        CHECK(received == 12);
+        CHECK(payload::copies == 1);
+    }
+
+    SECTION("a const emission copies for consuming slots")
+    {
+        const payload p { { 1, 2, 3 } };
+
+        s.emit(p);
+
+        CHECK(received == 12);
+        CHECK(payload::copies == 1);
+    }
+}
+
+TEST_CASE("move-only payloads are delivered", "[signal_slot]")
+{
+    std::unique_ptr<int> received {};
+
+    SECTION("signal")
+    {
+        nstd::signal_slot::signal<std::unique_ptr<int>> s;
+        size_t observed { 0 };
+
+        auto c1 { s.connect([&observed](const std::unique_ptr<int> &p){ observed += p != nullptr; }) };
+        auto c2 { s.connect([&received](std::unique_ptr<int> &&p){ received = std::move(p); }) };
+
+        s.emit(std::make_unique<int>(42));
+
+        CHECK(observed == 1);
+        REQUIRE(received);
+        CHECK(*received == 42);
+    }
+
+    SECTION("signal_ex and concurrent_signal")
+    {
+        nstd::signal_slot::signal_ex<std::unique_ptr<int>> s1;
+        nstd::signal_slot::concurrent_signal<std::unique_ptr<int>> s2;
+        int total { 0 };
+
+        auto c1 { s1.connect([&total](nstd::signal_slot::signal_base*, std::unique_ptr<int> &&p){ total += *p; }) };
+        auto c2 { s2.connect([&total](std::unique_ptr<int> &&p){ total += *p; }) };
+
+        s1.emit(std::make_unique<int>(1));
+        s2.emit(std::make_unique<int>(2));
+
+        CHECK(total == 3);
+    }
+
+    SECTION("bridged_signal")
+    {
+        nstd::signal_slot::bridged_signal<std::unique_ptr<int>> s;
+
+        auto c { s.connect([&received](std::unique_ptr<int> &&p){ received = std::move(p); }) };
+
+        s.emit(std::make_unique<int>(7));
+        s.invoke_all();
+
+        REQUIRE(received);
+        CHECK(*received == 7);
+    }
+
+    SECTION("throttled_signal")
+    {
+        nstd::signal_slot::throttled_signal<std::unique_ptr<int>> s { u8"throttled", 1ms };
+        std::atomic_int total { 0 };
+
+        auto c { s.connect([&total](std::unique_ptr<int> &&p){ total += *p; }) };
+
+        for (int i = 1; i <= 3; ++i) s.emit(std::make_unique<int>(i));
+
+        CHECK(wait_for([&total]{ return total == 6; }));
+    }
+
+    SECTION("queued_signal")
+    {
+        nstd::signal_slot::queued_signal<std::unique_ptr<int>> s;
+        std::atomic_int total { 0 };
+
+        auto c { s.connect([&total](std::unique_ptr<int> &&p){ total += *p; }) };
+
+        for (int i = 1; i <= 3; ++i) s.emit(std::make_unique<int>(i));
+
+        CHECK(wait_for([&total]{ return total == 6; }));
+    }
+}
+
+TEST_CASE("queued emissions are moved through the queue", "[signal_slot]")
+{
+    std::atomic_size_t received { 0 };
+    auto consume { [&received](payload &&p){ payload owned { std::move(p) }; received += std::size(owned.data); } };
+
+    payload::copies = 0;
+
+    {
+        nstd::signal_slot::bridged_signal<payload> s;
+        auto c { s.connect(consume) };
+
+        s.emit(payload { { 1, 2 } });
+        s.invoke_all();
+    }
+
+    {
+        nstd::signal_slot::throttled_signal<payload> s { u8"throttled", 1ms };
+        auto c { s.connect(consume) };
+
+        s.emit(payload { { 1, 2 } });
+
+        REQUIRE(wait_for([&received]{ return received == 4; }));
+    }
+
+    {
+        nstd::signal_slot::queued_signal<payload> s;
+        auto c { s.connect(consume) };
+
+        s.emit(payload { { 1, 2 } });
+
+        REQUIRE(wait_for([&received]{ return received == 6; }));
+    }
+
+    CHECK(payload::copies == 0);
+}
+
+TEST_CASE("queued signals are destroyed while other threads emit", "[signal_slot]")
+{
+    constexpr int emissions { 20000 };
+
+    nstd::signal_slot::queued_signal<int> kept;
+    std::atomic_int kept_total { 0 }, own_total { 0 }, own_expected { 0 };
+
+    auto c { kept.connect([&kept_total](int v){ kept_total += v; }) };
+
+    std::vector<std::jthread> producers;
+
+    for (int t = 0; t < 2; ++t) producers.emplace_back([&kept]{ for (int i = 0; i < emissions; ++i) kept.emit(1); });
+
+    for (int round = 0; round < 200; ++round)
+    {
+        nstd::signal_slot::connection own;
+        nstd::signal_slot::queued_signal<int> temporary;
+
+        own = temporary.connect([&own_total](int v){ own_total += v; });
+
+        for (int i = 0; i < 5; ++i) temporary.emit(1), ++own_expected;
+    }
+
+    producers.clear();
+
+    CHECK(own_total == own_expected);
+    REQUIRE(wait_for([&kept_total]{ return kept_total == 2 * emissions; }));
+}
+
+TEST_CASE("queued signal producers share the free queue nodes", "[signal_slot]")
+{
+    struct node_scope {};
+
+    nstd::signal_slot::queued_signal_scoped<node_scope, int> s;
+    std::atomic_int delivered { 0 };
+    std::atomic_bool first_done { false }, second_done { false };
+    size_t second_allocations { 0 };
+
+    auto c { s.connect([&delivered](int){ ++delivered; }) };
+
+    std::jthread first { [&]
+    {
+        for (int i = 0; i < 100; ++i) s.emit(1);
+
+        first_done = true;
+
+        while (!second_done) std::this_thread::sleep_for(1ms);
+    } };
+
+    REQUIRE(wait_for([&]{ return first_done && delivered == 100; }));
+
+    std::jthread { [&]
+    {
+        auto before { allocations };
+
+        for (int i = 0; i < 200; ++i) s.emit(1);
+
+        second_allocations = allocations - before;
+    } }.join();
+
+    second_done = true;
+
+    CHECK(second_allocations == 0);
+    CHECK(wait_for([&delivered]{ return delivered == 300; }));
+}
+
+TEST_CASE("bounded queues apply their overflow policy", "[signal_slot]")
+{
+    using nstd::signal_slot::overflow_policy;
+
+    std::vector<int> received;
+
+    SECTION("block")
+    {
+        nstd::signal_slot::bridged_signal<int> s { u8"block"s, 2, overflow_policy::block };
+        std::atomic_bool producer_done { false };
+
+        s.set_emit_functor([](auto*){ return true; });
+
+        auto c { s.connect([&received](int v){ received.push_back(v); }) };
+
+        std::jthread producer { [&]
+        {
+            for (int i = 1; i <= 3; ++i) s.emit(i);
+
+            producer_done = true;
+        } };
+
+        REQUIRE(wait_for([&s]{ return s.get_queue_size() == 2; }));
+
+        std::this_thread::sleep_for(50ms);
+
+        CHECK_FALSE(producer_done);
+
+        s.invoke_next();
+
+        REQUIRE(wait_for([&producer_done]{ return producer_done.load(); }));
+
+        producer.join();
+        s.invoke_all();
+
+        CHECK(received == std::vector { 1, 2, 3 });
+        CHECK(s.get_dropped_count() == 0);
+        CHECK(s.get_coalesced_count() == 0);
+    }
+
+    SECTION("drop_newest")
+    {
+        nstd::signal_slot::bridged_signal<int> s { u8"drop_newest"s, 2, overflow_policy::drop_newest };
+
+        s.set_emit_functor([](auto*){ return true; });
+
+        auto c { s.connect([&received](int v){ received.push_back(v); }) };
+
+        for (int i = 1; i <= 5; ++i) s.emit(i);
+
+        s.invoke_all();
+
+        CHECK(received == std::vector { 1, 2 });
+        CHECK(s.get_dropped_count() == 3);
+        CHECK(s.get_coalesced_count() == 0);
+    }
+
+    SECTION("coalesce_by_key")
+    {
+        nstd::signal_slot::bridged_signal<int, int> s { u8"coalesce_by_key"s, 2, overflow_policy::coalesce_by_key };
+
+        s.set_emit_functor([](auto*){ return true; });
+
+        s.set_coalesce_key([](const int &key, const int&){ return static_cast<size_t>(key); });
+
+        auto c { s.connect([&received](int key, int v){ received.push_back(key * 100 + v); }) };
+
+        s.emit(1, 10);
+        s.emit(2, 20);
+        s.emit(1, 11);
+        s.emit(1, 12);
+        s.emit(3, 30);
+        s.invoke_all();
+
+        CHECK(received == std::vector { 220, 330 });
+        CHECK(s.get_dropped_count() == 1);
+        CHECK(s.get_coalesced_count() == 2);
+    }
+}
+
+TEST_CASE("timer wheels run, cancel and wait for timers", "[signal_slot]")
+{
+    using timer_state = nstd::signal_slot::timer_wheel::timer_state;
+
+    nstd::signal_slot::timer_wheel wheel { 2 };
+    std::atomic_int runs { 0 };
+
+    auto late { wheel.schedule(1h, [&runs]{ ++runs; }) };
+
+    CHECK(late->state == timer_state::scheduled);
+    CHECK(wheel.cancel(late));
+    CHECK(late->state == timer_state::cancelled);
+
+    std::atomic_bool started { false }, finished { false }, finished_on_cancel { false }, cancelled { true };
+
+    auto slow { wheel.schedule(0ms, [&]{ started = true; std::this_thread::sleep_for(50ms); finished = true; }) };
+
+    REQUIRE(wait_for([&started]{ return started.load(); }));
+    CHECK(slow->state == timer_state::running);
+
+    auto other { wheel.schedule(0ms, [&]{ cancelled = wheel.cancel(slow); finished_on_cancel = finished.load(); }) };
+
+    REQUIRE(wait_for([&other]{ return other->state == timer_state::done; }));
+    CHECK_FALSE(cancelled);
+    CHECK(finished_on_cancel);
+    CHECK(slow->state == timer_state::done);
+
+    std::atomic_bool scheduled { false };
+    nstd::signal_slot::timer_wheel::timer_handle self;
+
+    self = wheel.schedule(0ms, [&]
+    {
+        while (!scheduled) std::this_thread::yield();
+
+        cancelled = wheel.cancel(self);
+        ++runs;
+    });
+    scheduled = true;
+
+    REQUIRE(wait_for([&self]{ return self->state == timer_state::done; }));
+    CHECK_FALSE(cancelled);
+    CHECK(runs == 1);
+}
+
+TEST_CASE("throttled signals destroyed from another dispatcher wait for their delivery", "[signal_slot]")
+{
+    nstd::signal_slot::timer_wheel wheel { 2 };
+    nstd::signal_slot::connection c1, c2;
+    auto victim { std::make_unique<nstd::signal_slot::throttled_signal<int>>(u8"victim", 1ms, wheel) };
+    nstd::signal_slot::throttled_signal<int> killer { u8"killer", 1ms, wheel };
+    std::atomic_bool started { false }, finished { false }, finished_on_destroy { false }, destroyed { false };
+
+    c1 = victim->connect([&](int){ started = true; std::this_thread::sleep_for(50ms); finished = true; });
+    c2 = killer.connect([&](int)
+    {
+        while (!started) std::this_thread::yield();
+
+        victim.reset();
+        finished_on_destroy = finished.load();
+        destroyed = true;
+    });
+
+    victim->emit(1);
+    killer.emit(1);
+
+    REQUIRE(wait_for([&destroyed]{ return destroyed.load(); }));
+    CHECK(finished_on_destroy);
+}
+
+TEST_CASE("periodic timer services keep absolute deadlines", "[signal_slot]")
+{
+    using clock_type = nstd::signal_slot::timer_service::clock_type;
+
+    nstd::signal_slot::timer_service service;
+    std::atomic_int ticks { 0 };
+    auto start { clock_type::now() };
+    std::atomic<clock_type::time_point> last { start };
+
+    auto t { service.schedule_every(10ms, [&]{ std::this_thread::sleep_for(3ms); last = clock_type::now(); ++ticks; }) };
+
+    REQUIRE(wait_for([&ticks]{ return ticks >= 20; }));
+    service.cancel(t);
+
+    auto elapsed { last.load() - start };
+    auto expected { 10ms * ticks.load() + 3ms };
+
+    CHECK(elapsed >= expected - 1ms);
+    CHECK(elapsed < expected + 30ms);
+}
+
+TEST_CASE("timer signals are stopped from their own slot", "[signal_slot]")
+{
+    nstd::signal_slot::timer_service service;
+    nstd::signal_slot::timer_signal<> timer { u8"timer", 1ms, service };
+    std::atomic_int ticks { 0 };
+
+    auto c { timer.connect([&ticks](auto *s){ if (++ticks == 3) s->stop_timer(); }) };
+
+    timer.start_timer();
+
+    REQUIRE(wait_for([&ticks]{ return ticks >= 3; }));
+    std::this_thread::sleep_for(20ms);
+    CHECK(ticks == 3);
+    CHECK(service.size() == 0);
+}
+
+TEST_CASE("timer tasks outliving their service skip their callbacks", "[signal_slot]")
+{
+    using timer_service = nstd::signal_slot::timer_service;
+
+    std::mutex lock;
+    std::vector<timer_service::task_type> queue;
+    std::atomic_int runs { 0 };
+    auto service { std::make_unique<timer_service>([&](timer_service::task_type &&task){ std::scoped_lock l(lock); queue.push_back(std::move(task)); }) };
+
+    service->schedule_after(0ms, [&runs]{ ++runs; });
+
+    REQUIRE(wait_for([&]{ std::scoped_lock l(lock); return !std::empty(queue); }));
+
+    service.reset();
+
+    for (auto &task : queue) task();
+
+    CHECK(runs == 0);
+
+    timer_service other;
+    std::atomic_bool on_executor { false };
+
+    other.set_executor([&](timer_service::task_type &&task){ on_executor = true; task(); });
+    other.schedule_after(0ms, [&runs]{ ++runs; });
+
+    REQUIRE(wait_for([&runs]{ return runs == 1; }));
+    CHECK(on_executor);
+}
+
+TEST_CASE("coalescing signals deliver a burst from many threads once per tick", "[signal_slot]")
+{
+    constexpr int producers_count { 4 }, emissions { 2000 };
+
+    nstd::signal_slot::timer_wheel wheel { 1 };
+    nstd::signal_slot::connection c;
+    nstd::signal_slot::coalescing_signal<int> s { u8"coalescing", 200ms, wheel };
+    std::atomic_int deliveries { 0 }, last { 0 };
+    std::atomic_bool go { false };
+
+    c = s.connect([&](int v){ ++deliveries; last = v; });
+
+    {
+        std::vector<std::jthread> producers;
+
+        for (int t = 0; t < producers_count; ++t) producers.emplace_back([&go, &s]{ while (!go) std::this_thread::yield(); for (int i = 1; i <= emissions; ++i) s.emit(i); });
+
+        go = true;
+    }
+
+    CHECK(s.has_pending());
+    REQUIRE(wait_for([&deliveries]{ return deliveries > 0; }));
+    std::this_thread::sleep_for(50ms);
+    CHECK(deliveries == 1);
+    CHECK(last == emissions);
+    CHECK(s.get_coalesced_count() == producers_count * emissions - 1);
+    CHECK_FALSE(s.has_pending());
+
+    s.emit(1);
+    s.emit(2);
+
+    REQUIRE(wait_for([&deliveries]{ return deliveries == 2; }));
+    CHECK(last == 2);
+}
+
+TEST_CASE("signal sets look up string keys by view from many threads", "[signal_slot]")
+{
+    nstd::signal_slot::signal_set<std::u8string, int> set { 4 };
+    std::atomic_int total { 0 };
+
+    auto c { set[u8"route"].connect([&total](int value){ total += value; }) };
+
+    CHECK(set.get_shard_count() == 4);
+    CHECK(set.exists(std::u8string_view { u8"route" }));
+    CHECK(&set.get_signal(std::u8string_view { u8"route" }) == &set[u8"route"s]);
+
+    {
+        std::vector<std::jthread> threads;
+
+        for (int t = 0; t < 4; ++t)
+            threads.emplace_back([&set, t]
+            {
+                for (int i = 0; i < 100; ++i)
+                {
+                    set[std::u8string_view { u8"route" }].emit(1);
+                    (void)set[u8"thread"s + static_cast<char8_t>(u8'0' + t)];
+                }
+            });
+    }
+
+    CHECK(total == 400);
+    CHECK(set.get_signal_count() == 5);
+    CHECK(std::distance(std::begin(set), std::end(set)) == 5);
+}
+
+TEST_CASE("signal sets create signals through an overridden get_signal", "[signal_slot]")
+{
+    struct counting_set : nstd::signal_slot::signal_set<std::u8string, int>
+    {
+        using base_class = nstd::signal_slot::signal_set<std::u8string, int>;
+        using base_class::get_signal;
+
+        int calls { 0 };
+
+        signal_type &get_signal(const key_type &key) override
+        {
+            ++calls;
+
+            return base_class::get_signal(key);
+        }
+    };
+
+    counting_set set;
+
+    auto &created { set[std::u8string_view { u8"view" }] };
+
+    CHECK(set.calls == 1);
+    CHECK(&set.get_signal(std::u8string_view { u8"view" }) == &created);
+    CHECK(set.calls == 1);
+    CHECK(&set[u8"view"s] == &created);
+    CHECK(set.calls == 2);
+}
+
+TEST_CASE("parallel emission of a signal set emits every signal once", "[signal_slot]")
+{
+    nstd::thread_pool pool { 4 };
+    nstd::signal_slot::signal_set<int, int> set;
+    std::vector<std::atomic_int> counts(64);
+    std::vector<nstd::signal_slot::connection> connections;
+
+    for (int i = 0; i < 64; ++i) connections.push_back(set[i].connect([&counts, i](int value){ counts[i] += value; }));
+
+    set.set_executor(nstd::signal_slot::make_executor(pool));
+    set.set_chunk_size(3);
+    set.emit_parallel(1);
+
+    CHECK(std::all_of(std::begin(counts), std::end(counts), [](auto &&count){ return count == 1; }));
+
+    connections.push_back(set[5].connect([](int){ throw std::runtime_error { "slot failed" }; }));
+
+    CHECK_THROWS_AS(set.emit_parallel(1), std::runtime_error);
+    CHECK(std::all_of(std::begin(counts), std::end(counts), [](auto &&count){ return count == 2; }));
+}
+
+TEST_CASE("instrumented signals report emissions, slot latencies and queue gauges", "[signal_slot]")
+{
+    nstd::signal_slot::instrumented_signal<int> s { u8"measured \"signal\"" };
+    int total { 0 };
+
+    auto c1 { s.connect([&total](int value){ total += value; }) };
+    auto c2 { s.connect([](int){ std::this_thread::sleep_for(1ms); }) };
+
+    for (int i = 0; i < 10; ++i) s.emit(i);
+
+    REQUIRE(s.metrics() != nullptr);
+    CHECK(total == 45);
+    CHECK(s.metrics()->get_emission_count() == 10);
+
+    auto latencies { s.metrics()->get_slot_latencies() };
+
+    REQUIRE(std::size(latencies) == 2);
+    CHECK(latencies[0].second->count() == 10);
+    CHECK(latencies[1].second->min() >= 1'000'000);
+    CHECK(latencies[1].second->percentile(50) >= latencies[1].second->min());
+    CHECK(latencies[1].second->percentile(100) == latencies[1].second->max());
+
+    nstd::signal_slot::instrumented_bridged_signal<int> bridged { u8"bridged"s, [](auto*){ return true; } };
+
+    bridged.set_capacity(2, nstd::signal_slot::overflow_policy::drop_oldest);
+
+    for (int i = 0; i < 3; ++i) bridged.emit(i);
+
+    CHECK(bridged.metrics()->read_gauge(nstd::signal_slot::signal_metrics::gauge::queue_depth) == 2);
+    CHECK(bridged.metrics()->read_gauge(nstd::signal_slot::signal_metrics::gauge::dropped) == 1);
+    CHECK_FALSE(s.metrics()->read_gauge(nstd::signal_slot::signal_metrics::gauge::queue_depth));
+
+    auto json { nstd::signal_slot::signal_metrics_registry::global().to_json() };
+    auto text { nstd::signal_slot::signal_metrics_registry::global().to_text() };
+
+    CHECK(json.find("\"name\":\"measured \\\"signal\\\"\",\"emissions\":10") != std::string::npos);
+    CHECK(json.find("\"queue_depth\":2") != std::string::npos);
+    CHECK(text.find("signal \"bridged\": emissions=0 queue_depth=2 dropped=1 coalesced=0") != std::string::npos);
+
+    CHECK(nstd::signal_slot::signal<int>{}.metrics() == nullptr);
+    CHECK(sizeof(nstd::signal_slot::signal<int>) < sizeof(nstd::signal_slot::instrumented_signal<int>));
+
+    for (int i = 0; i < 100; ++i) s.connect([](int){}).disconnect(), s.emit(i);
+
+    c2.disconnect();
+    s.emit(0);
+
+    latencies = s.metrics()->get_slot_latencies();
+
+    REQUIRE(std::size(latencies) == 1);
+    CHECK(latencies[0].second->count() == 111);
+
+    s.clear();
+
+    CHECK(std::empty(s.metrics()->get_slot_latencies()));
+
+    nstd::signal_slot::metrics_instrumentation instrumentation;
+    auto moved { std::move(instrumentation) };
+
+    REQUIRE(instrumentation.metrics() == nullptr);
+
+    instrumentation.count_emissions(1);
+    instrumentation.remove_slot(nstd::signal_slot::slot_id { 1 });
+
+    CHECK(instrumentation.slot_latency(nstd::signal_slot::slot_id { 1 }) == nullptr);
+    CHECK(moved.metrics()->get_emission_count() == 0);
+}
+
+TEST_CASE("rate-limited signals deliver bursts and then the sustained rate", "[signal_slot]")
+{
+    nstd::signal_slot::rate_limited_signal<std::unique_ptr<int>> s { u8"rate_limited", 20.0, 3 };
+    std::atomic_int delivered { 0 };
+
+    auto c { s.connect([&delivered](std::unique_ptr<int> &&p){ delivered += *p; }) };
+    auto start { std::chrono::steady_clock::now() };
+
+    for (int i = 0; i < 5; ++i) s.emit(std::make_unique<int>(1));
+
+    REQUIRE(wait_for([&delivered]{ return delivered == 3; }));
+    CHECK(std::chrono::steady_clock::now() - start < 45ms);
+    REQUIRE(wait_for([&delivered]{ return delivered == 5; }));
+    CHECK(std::chrono::steady_clock::now() - start >= 95ms);
+    CHECK(s.get_burst() == 3);
+    CHECK(s.get_queue_size() == 0);
+}
+
+TEST_CASE("rate-limited signals sustain rates above the resolution of the timer wheel", "[signal_slot]")
+{
+    constexpr int emissions { 5000 };
+
+    nstd::signal_slot::rate_limited_signal<int> s { u8"fast", 50000.0 };
+    std::atomic_int delivered { 0 };
+
+    auto c { s.connect([&delivered](int){ ++delivered; }) };
+    auto start { std::chrono::steady_clock::now() };
+
+    for (int i = 0; i < emissions; ++i) s.emit(i);
+
+    REQUIRE(wait_for([&delivered]{ return delivered == emissions; }));
+
+    auto elapsed { std::chrono::steady_clock::now() - start };
+
+    CHECK(elapsed >= 95ms);
+    CHECK(elapsed < 500ms);
+    CHECK(s.get_burst() == 1);
+}
+
+TEST_CASE("bridged signals drain in batches on an event loop strand", "[signal_slot]")
+{
+    std::atomic_int wakeups { 0 };
+    nstd::signal_slot::event_loop_strand loop { [&wakeups]{ ++wakeups; } };
+    std::vector<int> received;
+
+    {
+        nstd::signal_slot::bridged_signal<std::unique_ptr<int>> s;
+
+        s.bridge_to(loop.executor());
+
+        auto c { s.connect([&received, &loop](std::unique_ptr<int> &&p){ CHECK(loop.running_in_this_thread()); received.push_back(*p); }) };
+
+        for (int i = 0; i < 100; ++i) s.emit(std::make_unique<int>(i));
+
+        CHECK(std::empty(received));
+        CHECK(s.get_queue_size() == 100);
+        CHECK(wakeups == 1);
+        CHECK(loop.run_pending() == 1);
+        REQUIRE(std::size(received) == 100);
+        CHECK(std::is_sorted(std::begin(received), std::end(received)));
+
+        s.emit(std::make_unique<int>(100));
+        s.emit(std::make_unique<int>(101));
+
+        CHECK(wakeups == 2);
+    }
+
+    CHECK(loop.run_pending() == 1);
+    CHECK(std::size(received) == 100);
+}
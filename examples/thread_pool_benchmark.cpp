@@ -0,0 +1,349 @@
+/*
+MIT License
+Copyright (c) 2019 Arlen Keshabyan (arlen.albert@gmail.com)
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "thread_pool.hpp"
+#include "utilities.hpp"
+#include "benchmark_results.hpp"
+
+using clock_type = std::chrono::steady_clock;
+
+/**
+ * @brief The single-queue pool nstd::thread_pool used before work stealing, kept as the baseline
+ */
+class shared_queue_pool
+{
+public:
+    explicit shared_queue_pool(long num_threads)
+    {
+        while (--num_threads >= 0) _worker_threads.emplace_back([this]
+        {
+            while (!_cancelled)
+            {
+                std::function<void()> task;
+
+                if (_task_queue.wait_pop(task)) task();
+            }
+        });
+    }
+
+    ~shared_queue_pool()
+    {
+        _cancelled = true;
+
+        _task_queue.invalidate();
+
+        for (auto &thread : _worker_threads) thread.join();
+    }
+
+    template<typename Functor>
+    auto enqueue(Functor &&functor)
+    {
+        using result_type = std::invoke_result_t<Functor>;
+
+        auto task { std::make_shared<std::packaged_task<result_type()>>(std::forward<Functor>(functor)) };
+        auto result { task->get_future() };
+
+        _task_queue.push([task = std::move(task)]{ (*task)(); });
+
+        return result;
+    }
+
+private:
+    std::atomic_bool _cancelled { false };
+    nstd::thread_safe_queue<std::function<void()>> _task_queue {};
+    std::vector<std::thread> _worker_threads {};
+};
+
+void wait_for(const std::atomic_size_t &counter, size_t expected)
+{
+    while (counter.load(std::memory_order_acquire) < expected) std::this_thread::yield();
+}
+
+/**
+ * @brief Tiny tasks submitted one by one from a thread outside the pool
+ */
+template<typename pool_type>
+double external_submission(pool_type &pool, size_t task_count)
+{
+    std::atomic_size_t completed { 0 };
+
+    auto begin { clock_type::now() };
+
+    for (size_t i = 0; i < task_count; ++i) (void)pool.enqueue([&completed]{ completed.fetch_add(1, std::memory_order_release); });
+
+    wait_for(completed, task_count);
+
+    std::chrono::duration<double> elapsed { clock_type::now() - begin };
+
+    return static_cast<double>(task_count) / elapsed.count();
+}
+
+template<typename pool_type>
+void spawn_tree(pool_type &pool, std::atomic_size_t &completed, int depth)
+{
+    if (depth == 0)
+    {
+        completed.fetch_add(1, std::memory_order_release);
+
+        return;
+    }
+
+    for (int child = 0; child < 2; ++child) (void)pool.enqueue([&pool, &completed, depth]{ spawn_tree(pool, completed, depth - 1); });
+}
+
+/**
+ * @brief A binary tree of tiny tasks where every task is submitted from inside the pool
+ */
+template<typename pool_type>
+double nested_submission(pool_type &pool, int depth)
+{
+    const size_t leaf_count { size_t { 1 } << depth };
+    const size_t task_count { 2 * leaf_count - 2 };
+    std::atomic_size_t completed { 0 };
+
+    auto begin { clock_type::now() };
+
+    spawn_tree(pool, completed, depth);
+    wait_for(completed, leaf_count);
+
+    std::chrono::duration<double> elapsed { clock_type::now() - begin };
+
+    return static_cast<double>(task_count) / elapsed.count();
+}
+
+template<typename pool_type>
+void task_throughput(benchmark_results &results, std::string_view variant, long thread_count)
+{
+    constexpr size_t external_task_count { 200'000 };
+    constexpr int tree_depth { 17 };
+
+    pool_type pool { thread_count };
+
+    const auto parameter { "threads=" + std::to_string(thread_count) };
+    const auto external { external_submission(pool, external_task_count) };
+    const auto nested { nested_submission(pool, tree_depth) };
+
+    results.add("external_submission", variant, parameter, "throughput", external, "tasks/s");
+    results.add("nested_submission", variant, parameter, "throughput", nested, "tasks/s");
+
+    std::cout << std::left << std::setw(20) << variant << std::setw(14) << parameter << std::right << std::fixed << std::setprecision(0)
+              << std::setw(16) << external << std::setw(16) << nested << std::endl;
+}
+
+void benchmark_task_throughput(benchmark_results &results)
+{
+    std::cout << "=== Fine-grained task throughput ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "pool" << std::setw(14) << "threads" << std::right << std::setw(16) << "external/s" << std::setw(16) << "nested/s" << std::endl;
+
+    for (long thread_count : { 1, 2, 4, 8, 16, 32, 64 })
+    {
+        task_throughput<shared_queue_pool>(results, "shared_queue", thread_count);
+        task_throughput<nstd::thread_pool_lite>(results, "thread_pool_lite", thread_count);
+        task_throughput<nstd::thread_pool>(results, "work_stealing", thread_count);
+    }
+}
+
+/**
+ * @brief Tiny tasks submitted from outside the pool through enqueue, submit and post
+ */
+void benchmark_submission_overhead(benchmark_results &results)
+{
+    constexpr size_t task_count { 500'000 };
+
+    std::cout << "=== Submission overhead ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "method" << std::setw(14) << "threads" << std::right << std::setw(16) << "tasks/s" << std::endl;
+
+    for (long thread_count : { 1, 4 })
+    {
+        nstd::thread_pool pool { thread_count };
+        std::atomic_size_t completed { 0 };
+        std::vector<std::future<void>> futures;
+
+        futures.reserve(task_count);
+
+        const auto parameter { "threads=" + std::to_string(thread_count) };
+        const auto measure = [&](std::string_view method, auto &&submit_one)
+        {
+            completed = 0;
+            futures.clear();
+
+            auto begin { clock_type::now() };
+
+            for (size_t i = 0; i < task_count; ++i) submit_one([&completed]{ completed.fetch_add(1, std::memory_order_release); });
+
+            wait_for(completed, task_count);
+
+            std::chrono::duration<double> elapsed { clock_type::now() - begin };
+            const auto throughput { static_cast<double>(task_count) / elapsed.count() };
+
+            results.add("submission_overhead", method, parameter, "throughput", throughput, "tasks/s");
+
+            std::cout << std::left << std::setw(20) << method << std::setw(14) << parameter << std::right << std::fixed << std::setprecision(0) << std::setw(16) << throughput << std::endl;
+        };
+
+        measure("enqueue", [&](auto &&task){ futures.push_back(pool.enqueue(task)); });
+        measure("submit", [&](auto &&task){ futures.push_back(pool.submit(task)); });
+        measure("post", [&](auto &&task){ pool.post(task); });
+    }
+}
+
+/**
+ * @brief Short repeated parallel loops and sorts, spawning threads per call versus reusing the pool
+ */
+void benchmark_parallel_algorithms(benchmark_results &results)
+{
+    constexpr size_t item_count { 1'000'000 };
+    constexpr int rounds { 20 };
+
+    nstd::thread_pool pool;
+    std::vector<double> values(item_count, 2.0);
+    std::vector<int> unsorted(item_count);
+    std::mt19937 random { 42 };
+
+    for (auto &value : unsorted) value = static_cast<int>(random());
+
+    std::cout << "=== Parallel algorithms ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "algorithm" << std::setw(14) << "variant" << std::right << std::setw(16) << "ms/call" << std::endl;
+
+    const auto measure = [&](std::string_view algorithm, std::string_view variant, auto &&call)
+    {
+        auto begin { clock_type::now() };
+
+        for (int round = 0; round < rounds; ++round) call();
+
+        std::chrono::duration<double, std::milli> elapsed { clock_type::now() - begin };
+        const auto per_call { elapsed.count() / rounds };
+
+        results.add(algorithm, variant, "items=" + std::to_string(item_count), "time", per_call, "ms");
+
+        std::cout << std::left << std::setw(20) << algorithm << std::setw(14) << variant << std::right << std::fixed << std::setprecision(3) << std::setw(16) << per_call << std::endl;
+    };
+    const auto update { [](double &value){ value = std::sqrt(value + 1.0); } };
+
+    measure("parallel_for_each", "threads", [&]{ nstd::utilities::parallel_for_each(std::begin(values), std::end(values), update); });
+    measure("parallel_for_each", "pool", [&]{ nstd::utilities::parallel_for_each(pool, std::begin(values), std::end(values), update); });
+    measure("parallel_sort", "async", [&]{ auto data { unsorted }; nstd::utilities::parallel_sort(std::begin(data), std::end(data), 10'000); });
+    measure("parallel_sort", "pool", [&]{ auto data { unsorted }; nstd::utilities::parallel_sort(pool, std::begin(data), std::end(data), 10'000); });
+}
+
+/**
+ * @brief Latency of short tasks while the pool is saturated with background work, per submission lane
+ */
+void benchmark_priority_latency(benchmark_results &results)
+{
+    using namespace std::chrono_literals;
+
+    constexpr size_t sample_count { 200 };
+    constexpr int backlog { 400 };
+
+    std::cout << "=== Latency under background saturation ===" << std::endl;
+    std::cout << std::left << std::setw(20) << "lane" << std::setw(14) << "" << std::right << std::setw(16) << "p50 (us)" << std::setw(16) << "p99 (us)" << std::endl;
+
+    for (auto [variant, priority] : { std::pair { "normal", nstd::task_priority::normal }, std::pair { "high", nstd::task_priority::high } })
+    {
+        std::atomic_bool stop { false };
+        std::atomic_int queued { 0 };
+        std::vector<double> latencies;
+        nstd::thread_pool pool { 4 };
+
+        const auto background { [&stop, &queued]
+        {
+            --queued;
+
+            auto until { clock_type::now() + 100us };
+
+            while (!stop && clock_type::now() < until) { }
+        } };
+
+        const auto top_up { [&]{ for (; queued < backlog; ++queued) pool.post(nstd::task_priority::normal, background); } };
+
+        top_up();
+
+        for (size_t sample = 0; sample < sample_count; ++sample)
+        {
+            auto submitted { clock_type::now() };
+            auto started { pool.submit(priority, []{ return clock_type::now(); }) };
+
+            if (started.wait_for(10s) != std::future_status::ready) break;
+
+            latencies.push_back(std::chrono::duration<double, std::micro> { started.get() - submitted }.count());
+
+            top_up();
+        }
+
+        stop = true;
+
+        std::sort(std::begin(latencies), std::end(latencies));
+
+        const auto percentile { [&latencies](double rank){ return std::empty(latencies) ? 0.0 : latencies[static_cast<size_t>(rank / 100 * static_cast<double>(std::size(latencies) - 1))]; } };
+
+        results.add("priority_latency", variant, "background=saturated", "latency_p50", percentile(50), "us");
+        results.add("priority_latency", variant, "background=saturated", "latency_p99", percentile(99), "us");
+        results.add("priority_latency", variant, "background=saturated", "samples", static_cast<double>(std::size(latencies)), "count");
+
+        std::cout << std::left << std::setw(20) << variant << std::setw(14) << "" << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(16) << percentile(50) << std::setw(16) << percentile(99) << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    std::string json_path, csv_path, label { "thread_pool" };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string_view arg { argv[i] };
+
+        if (arg.starts_with("--json=")) json_path = arg.substr(7);
+        else if (arg.starts_with("--csv=")) csv_path = arg.substr(6);
+        else if (arg.starts_with("--label=")) label = arg.substr(8);
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--json=<file>] [--csv=<file>] [--label=<text>]" << std::endl;
+
+            return 1;
+        }
+    }
+
+    benchmark_results results;
+
+    benchmark_task_throughput(results);
+    benchmark_submission_overhead(results);
+    benchmark_parallel_algorithms(results);
+    benchmark_priority_latency(results);
+
+    if (!std::empty(json_path)) std::ofstream { json_path } << results.to_json(label);
+    if (!std::empty(csv_path)) std::ofstream { csv_path } << results.to_csv(label);
+
+    return 0;
+}
@@ -0,0 +1,516 @@
+/*
+MIT License
+Copyright (c) 2019 Arlen Keshabyan (arlen.albert@gmail.com)
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "thread_pool.hpp"
+#include "utilities.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#define CATCH_CONFIG_MAIN
+#include "catch.hpp"
+
+using namespace std::literals;
+
+static thread_local size_t allocations { 0 };
+
+void *operator new(std::size_t size)
+{
+    ++allocations;
+
+    if (auto memory { std::malloc(size ? size : 1) }) return memory;
+
+    throw std::bad_alloc {};
+}
+
+void *operator new(std::size_t size, const std::nothrow_t &) noexcept
+{
+    ++allocations;
+
+    return std::malloc(size ? size : 1);
+}
+
+[[gnu::noinline]] void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void *memory, std::size_t) noexcept
+{
+    ::operator delete(memory);
+}
+
+template<typename Predicate>
+bool wait_for(Predicate &&predicate)
+{
+    for (auto deadline { std::chrono::steady_clock::now() + 10s }; !predicate(); std::this_thread::sleep_for(1ms))
+        if (std::chrono::steady_clock::now() > deadline) return false;
+
+    return true;
+}
+
+TEST_CASE("the global pool is left with queued tasks at exit", "[thread_pool]")
+{
+    // whether any of them started is up to the scheduler; exiting with the rest still queued
+    // must neither crash nor leak them, which running the tests under a leak checker shows
+    for (int i = 0; i < 1000; ++i) nstd::global_thread_pool::enqueue([]{ std::this_thread::sleep_for(10us); });
+
+    SUCCEED();
+}
+
+TEST_CASE("posting and submitting small tasks does not allocate once warmed up", "[thread_pool]")
+{
+    static constexpr int tasks { 1000 };
+
+    nstd::thread_pool pool { 2 };
+    std::atomic_int done { 0 };
+    std::vector<std::future<int>> results;
+
+    results.reserve(tasks);
+
+    auto post_round { [&]
+    {
+        auto before { allocations };
+
+        done = 0;
+
+        for (int i = 0; i < tasks; ++i) pool.post([&done]{ ++done; });
+
+        auto allocated { allocations - before };
+
+        REQUIRE(wait_for([&done]{ return done == tasks; }));
+
+        return allocated;
+    } };
+
+    auto submit_round { [&]
+    {
+        auto before { allocations };
+
+        for (int i = 0; i < tasks; ++i) results.push_back(pool.submit([i]{ return i; }));
+
+        auto allocated { allocations - before };
+        int total { 0 };
+
+        for (auto &result : results) total += result.get();
+
+        results.clear();
+
+        CHECK(total == tasks * (tasks - 1) / 2);
+
+        return allocated;
+    } };
+
+    for (int round = 0; round < 10; ++round) post_round(), submit_round();
+
+    CHECK(post_round() == 0);
+    CHECK(submit_round() == 0);
+}
+
+TEST_CASE("tasks posted from workers fan out and are stolen", "[thread_pool]")
+{
+    nstd::thread_pool pool { 4 };
+    std::atomic_int done { 0 };
+    std::function<void(int)> fan_out;
+
+    fan_out = [&](int depth)
+    {
+        ++done;
+
+        if (depth > 0) for (int i = 0; i < 2; ++i) pool.post([&fan_out, depth]{ fan_out(depth - 1); });
+    };
+
+    pool.post([&fan_out]{ fan_out(14); });
+
+    REQUIRE(wait_for([&done]{ return done == (1 << 15) - 1; }));
+
+    std::atomic_bool release { false };
+    std::atomic_int stolen { 0 };
+    std::mutex ids_mutex;
+    std::set<std::thread::id> ids;
+    std::thread::id poster;
+
+    pool.post([&]
+    {
+        poster = std::this_thread::get_id();
+
+        for (int i = 0; i < 100; ++i)
+            pool.post([&]
+            {
+                {
+                    std::scoped_lock lock { ids_mutex };
+
+                    ids.insert(std::this_thread::get_id());
+                }
+
+                ++stolen;
+            });
+
+        while (!release) std::this_thread::yield();
+    });
+
+    // the posting worker is busy until released, so the others have to steal its tasks
+    CHECK(wait_for([&stolen]{ return stolen == 100; }));
+
+    release = true;
+
+    CHECK_FALSE(ids.contains(poster));
+}
+
+TEST_CASE("sleeping workers are woken for every task", "[thread_pool]")
+{
+    nstd::thread_pool pool { 3 };
+    std::atomic_int done { 0 };
+
+    for (int round = 1; round <= 100; ++round)
+    {
+        if (round % 10 == 0) std::this_thread::sleep_for(5ms);
+
+        pool.post([&done]{ ++done; });
+
+        REQUIRE(wait_for([&done, round]{ return done == round; }));
+    }
+
+    std::vector<std::jthread> producers;
+
+    for (int t = 0; t < 4; ++t) producers.emplace_back([&pool, &done]{ for (int i = 0; i < 5000; ++i) pool.post([&done]{ ++done; }); });
+
+    producers.clear();
+
+    CHECK(wait_for([&done]{ return done == 100 + 4 * 5000; }));
+}
+
+TEST_CASE("pools are destroyed with work still queued", "[thread_pool]")
+{
+    auto alive { std::make_shared<int>(0) };
+
+    for (int round = 0; round < 20; ++round)
+    {
+        nstd::thread_pool pool { 3 };
+
+        for (int i = 0; i < 1000; ++i)
+            pool.post([alive, &pool]
+            {
+                pool.post([alive]{ std::this_thread::sleep_for(1us); });
+            });
+    }
+
+    CHECK(alive.use_count() == 1);
+}
+
+TEST_CASE("parallel loops visit every index once and rethrow the first exception", "[thread_pool]")
+{
+    nstd::thread_pool pool { 3 };
+    std::vector<std::atomic_int> visits(10007);
+
+    pool.parallel_for(0, static_cast<int>(std::size(visits)), 16, [&visits](int index){ ++visits[static_cast<size_t>(index)]; });
+
+    CHECK(std::all_of(std::begin(visits), std::end(visits), [](auto &v){ return v == 1; }));
+
+    std::vector<int> values(10007);
+
+    std::iota(std::begin(values), std::end(values), 1);
+    pool.parallel_for(values, 0, [](int &value){ value *= 2; });
+
+    CHECK(pool.parallel_reduce(values, 64, int64_t { 0 }, std::plus<>{}) == int64_t { 10007 } * 10008);
+    CHECK(pool.parallel_reduce(0, 100, 1, 0, std::plus<>{}, [](int index){ return index; }) == 4950);
+    CHECK(pool.parallel_reduce(5, 5, 1, 42, std::plus<>{}, [](int index){ return index; }) == 42);
+
+    CHECK_THROWS_AS(pool.parallel_for(0, 1000, 8, [](int index){ if (index == 500) throw std::runtime_error { "index" }; }), std::runtime_error);
+
+    std::list<int> list(1000, 1);
+    std::atomic_int total { 0 };
+
+    nstd::utilities::parallel_for_each(pool, std::begin(list), std::end(list), [&total](int value){ total += value; });
+
+    CHECK(total == 1000);
+}
+
+TEST_CASE("parallel loops and bulk submissions run from a pool worker", "[thread_pool]")
+{
+    nstd::thread_pool pool { 1 };
+
+    auto sum { pool.submit([&pool]
+    {
+        std::atomic_int total { 0 };
+
+        pool.parallel_for(0, 1000, 10, [&total](int index){ total += index; });
+
+        return total.load() + pool.parallel_reduce(0, 1000, 10, 0, std::plus<>{}, [](int index){ return index; });
+    }) };
+
+    REQUIRE(sum.wait_for(10s) == std::future_status::ready);
+    CHECK(sum.get() == 2 * 499500);
+
+    std::vector<std::function<int()>> tasks;
+
+    for (int i = 0; i < 100; ++i) tasks.emplace_back([i]{ if (i == 13) throw std::runtime_error { "bulk" }; return i; });
+
+    auto results { pool.enqueue_bulk(std::begin(tasks), std::end(tasks)) };
+
+    REQUIRE(std::size(results) == 100);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        if (i == 13) CHECK_THROWS_AS(results[13].get(), std::runtime_error);
+        else CHECK(results[static_cast<size_t>(i)].get() == i);
+    }
+
+    auto nested { pool.submit([&pool, &tasks]{ return pool.enqueue_bulk(std::begin(tasks), std::begin(tasks) + 10); }).get() };
+    int total { 0 };
+
+    for (auto &&result : nested) total += result.get();
+
+    CHECK(total == 45);
+}
+
+struct gated_pool
+{
+    nstd::thread_pool pool { 1 };
+    std::atomic_bool started { false }, released { false };
+    std::mutex order_mutex {};
+    std::vector<int> order {};
+
+    gated_pool()
+    {
+        pool.post([this]{ started = true; while (!released) std::this_thread::yield(); });
+
+        while (!started) std::this_thread::yield();
+    }
+
+    auto record(int value)
+    {
+        return [this, value]{ std::scoped_lock lock { order_mutex }; order.push_back(value); };
+    }
+
+    std::vector<int> release(size_t count)
+    {
+        released = true;
+
+        wait_for([this, count]{ std::scoped_lock lock { order_mutex }; return std::size(order) == count; });
+
+        std::scoped_lock lock { order_mutex };
+
+        return order;
+    }
+};
+
+TEST_CASE("lanes run high before normal before low", "[thread_pool]")
+{
+    using nstd::task_priority;
+
+    gated_pool gate;
+
+    gate.pool.post(task_priority::low, gate.record(3));
+    gate.pool.post(task_priority::normal, gate.record(2));
+    gate.pool.post(task_priority::high, gate.record(1));
+    gate.pool.post(task_priority::low, gate.record(4));
+    gate.pool.post(task_priority::high, gate.record(5));
+
+    CHECK(gate.release(5) == std::vector { 1, 5, 2, 3, 4 });
+}
+
+TEST_CASE("overdue tasks of lower lanes are promoted", "[thread_pool]")
+{
+    using nstd::task_priority;
+
+    gated_pool gate;
+
+    gate.pool.set_starvation_limit(task_priority::low, 1ms);
+
+    CHECK(gate.pool.get_starvation_limit(task_priority::low) == 1ms);
+
+    gate.pool.post(task_priority::low, gate.record(1));
+
+    std::this_thread::sleep_for(10ms);
+
+    gate.pool.post(task_priority::high, gate.record(2));
+    gate.pool.post(task_priority::high, gate.record(3));
+
+    CHECK(gate.release(3) == std::vector { 1, 2, 3 });
+    CHECK(gate.pool.get_lane_metrics(task_priority::low).starvation_promotions == 1);
+    CHECK(gate.pool.get_lane_metrics(task_priority::high).starvation_promotions == 0);
+}
+
+TEST_CASE("tasks with deadlines run earliest deadline first", "[thread_pool]")
+{
+    using nstd::task_priority;
+
+    gated_pool gate;
+    auto now { std::chrono::steady_clock::now() };
+
+    gate.pool.post_before(now + 30s, gate.record(3));
+    gate.pool.post_before(now + 10s, gate.record(1));
+    gate.pool.post_before(now + 20s, gate.record(2));
+    gate.pool.post_before(now - 1ms, gate.record(0));
+    gate.pool.post_before(now + 10s, gate.record(5), task_priority::high);
+
+    // the overdue task is due before the high one, so it is promoted ahead of it
+    CHECK(gate.release(5) == std::vector { 0, 5, 1, 2, 3 });
+
+    auto normal { gate.pool.get_lane_metrics(task_priority::normal) };
+
+    CHECK(normal.deadline_misses == 1);
+    CHECK(normal.starvation_promotions == 1);
+}
+
+TEST_CASE("lane metrics count submitted, started and waiting tasks", "[thread_pool]")
+{
+    using nstd::task_priority;
+
+    gated_pool gate;
+
+    for (int i = 0; i < 10; ++i) gate.pool.post(task_priority::low, gate.record(i));
+
+    auto queued { gate.pool.get_lane_metrics(task_priority::low) };
+
+    CHECK(queued.submitted == 10);
+    CHECK(queued.started == 0);
+    CHECK(queued.queued == 10);
+
+    std::this_thread::sleep_for(5ms);
+
+    REQUIRE(std::size(gate.release(10)) == 10);
+
+    auto low { gate.pool.get_lane_metrics(task_priority::low) };
+
+    CHECK(low.submitted == 10);
+    CHECK(low.started == 10);
+    CHECK(low.queued == 0);
+    CHECK(low.max_wait >= 5ms);
+    CHECK(low.total_wait >= 10 * 5ms);
+    CHECK(low.deadline_misses == 0);
+
+    auto normal { gate.pool.get_lane_metrics(task_priority::normal) };
+
+    CHECK(normal.submitted == 1);
+    CHECK(normal.started == 1);
+}
+
+TEST_CASE("pool timers go through their states", "[thread_pool]")
+{
+    using timer_state = nstd::thread_pool::timer_state;
+
+    nstd::thread_pool pool { 2 };
+    std::atomic_bool started { false }, released { false }, finished { false };
+
+    auto once { pool.schedule_after(20ms, [&]{ started = true; while (!released) std::this_thread::yield(); finished = true; }) };
+
+    CHECK(once->get_state() == timer_state::scheduled);
+    CHECK(pool.timer_count() == 1);
+    REQUIRE(wait_for([&started]{ return started.load(); }));
+    CHECK(once->get_state() == timer_state::running);
+
+    released = true;
+
+    REQUIRE(wait_for([&once]{ return once->get_state() == timer_state::done; }));
+    CHECK(finished);
+    CHECK_FALSE(pool.cancel(once));
+
+    std::atomic_int runs { 0 };
+    auto late { pool.schedule_after(1h, [&runs]{ ++runs; }) };
+
+    CHECK(pool.cancel(late));
+    CHECK(late->get_state() == timer_state::cancelled);
+    CHECK_FALSE(pool.cancel(late));
+
+    started = released = finished = false;
+
+    auto slow { pool.schedule_after(0ms, [&]{ started = true; std::this_thread::sleep_for(30ms); finished = true; }) };
+
+    REQUIRE(wait_for([&started]{ return started.load(); }));
+    CHECK_FALSE(pool.cancel(slow));
+    CHECK(finished);
+    CHECK(slow->get_state() == timer_state::cancelled);
+
+    nstd::thread_pool::timer_handle self;
+    std::atomic_bool cancelled_inside { true }, scheduled { false };
+
+    self = pool.schedule_every(1ms, [&]
+    {
+        while (!scheduled) std::this_thread::yield();
+
+        cancelled_inside = pool.cancel(self);
+        ++runs;
+    });
+    scheduled = true;
+
+    REQUIRE(wait_for([&self]{ return self->get_state() == timer_state::cancelled; }));
+    std::this_thread::sleep_for(10ms);
+    CHECK_FALSE(cancelled_inside);
+    CHECK(runs == 1);
+}
+
+TEST_CASE("periodic pool timers never overlap their runs", "[thread_pool]")
+{
+    nstd::thread_pool pool { 4 };
+    std::atomic_int runs { 0 }, running { 0 }, overlaps { 0 };
+
+    auto periodic { pool.schedule_every(1ms, [&]
+    {
+        if (++running > 1) ++overlaps;
+
+        std::this_thread::sleep_for(5ms);
+
+        --running;
+        ++runs;
+    }, nstd::task_priority::high) };
+
+    REQUIRE(wait_for([&runs]{ return runs >= 10; }));
+    pool.cancel(periodic);
+
+    auto after_cancel { runs.load() };
+
+    std::this_thread::sleep_for(20ms);
+
+    CHECK(overlaps == 0);
+    CHECK(runs == after_cancel);
+    CHECK(pool.get_lane_metrics(nstd::task_priority::high).started >= 10);
+}
+
+TEST_CASE("pools are destroyed with timers pending and running", "[thread_pool]")
+{
+    auto alive { std::make_shared<int>(0) };
+
+    for (int round = 0; round < 10; ++round)
+    {
+        nstd::thread_pool pool { 2 };
+
+        for (int i = 0; i < 50; ++i) pool.schedule_every(1ms, [alive]{ std::this_thread::sleep_for(100us); });
+
+        pool.schedule_after(1h, [alive]{});
+
+        std::this_thread::sleep_for(3ms);
+    }
+
+    CHECK(alive.use_count() == 1);
+}
@@ -20,6 +20,17 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <array>
+#include <atomic>
+#include <concepts>
+#include <cstring>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
 #include "signal_slot.hpp"
 
 namespace nstd
@@ -27,6 +38,92 @@ namespace nstd
 using namespace std::string_literals;
 using namespace std::string_view_literals;
 
+template<typename T> class live_property;
+
+/**
+ * @brief Defers the change notifications of live properties written on this thread until commit
+ *
+ * While the transaction is active, assignments to live_property objects are staged: repeated
+ * writes to a property overwrite each other and reads see the staged value, but no signal is
+ * emitted. On commit, every written property whose staged value differs from its current one
+ * goes through the changing/changed protocol once, in the order the properties were first
+ * written. The destructor commits, or rolls back if the scope is left by an exception.
+ * A transaction started while another one is active on the same thread joins the outer one.
+ */
+class live_property_transaction
+{
+public:
+    live_property_transaction() : _outer{ _current }, _uncaught_exceptions{ std::uncaught_exceptions() }
+    {
+        if (!_outer) _current = this;
+    }
+
+    live_property_transaction(const live_property_transaction &other) = delete;
+    live_property_transaction &operator=(const live_property_transaction &other) = delete;
+
+    ~live_property_transaction()
+    {
+        if (std::uncaught_exceptions() > _uncaught_exceptions) rollback();
+        else commit();
+    }
+
+    void commit()
+    {
+        finish(true);
+    }
+
+    void rollback()
+    {
+        finish(false);
+    }
+
+    static live_property_transaction *current() noexcept
+    {
+        return _current;
+    }
+
+private:
+    template<typename T> friend class live_property;
+
+    struct entry
+    {
+        void *property { nullptr };
+        void (*finish)(void *property, bool commit) { nullptr };
+    };
+
+    static inline thread_local live_property_transaction *_current { nullptr };
+
+    live_property_transaction *_outer { nullptr };
+    int _uncaught_exceptions { 0 };
+    std::vector<entry> _entries {};
+
+    void enlist(void *property, void (*finish)(void*, bool))
+    {
+        _entries.push_back({ property, finish });
+    }
+
+    void delist(void *property) noexcept
+    {
+        for (auto &&e : _entries) if (e.property == property) e.property = nullptr;
+    }
+
+    void finish(bool commit)
+    {
+        if (_current != this) return;
+
+        _current = nullptr;
+
+        for (size_t position = 0; position < std::size(_entries); ++position)
+        {
+            auto e { _entries[position] };
+
+            if (e.property) e.finish(e.property, commit);
+        }
+
+        _entries.clear();
+    }
+};
+
 template<typename T>
 class live_property
 {
@@ -49,7 +146,7 @@ public:
 
     live_property(const live_property &other)
     {
-        operator= (other._value);
+        operator= (other.value());
     }
 
     live_property(live_property &&other) noexcept
@@ -57,6 +154,11 @@ public:
         operator=(std::forward<live_property>(other));
     }
 
+    ~live_property()
+    {
+        if (_pending) _transaction->delist(this);
+    }
+
     live_property &operator=(value_type &&value)
     {
         return move_value(std::forward<value_type>(value));
@@ -64,12 +166,12 @@ public:
 
     live_property &operator=(live_property &&other) noexcept
     {
-        return operator=(std::move(other._value));
+        return operator=(std::move(other.current_value()));
     }
 
     live_property &operator=(const live_property &other)
     {
-        return operator= (other._value);
+        return operator= (other.value());
     }
 
     live_property &operator=(const value_type &value)
@@ -84,152 +186,138 @@ public:
 
     const value_type &value() const
     {
-        return _value;
+        return _pending ? *_pending : _value;
     }
 
     operator value_type() const
     {
-        return _value;
+        return value();
     }
 
     live_property &operator +=(const value_type &value)
     {
-        return move_value(_value + value);
+        return move_value(this->value() + value);
     }
 
     live_property &operator +=(const live_property &other)
     {
-        return operator += (other._value);
+        return operator += (other.value());
     }
 
     live_property &operator -=(const value_type &value)
     {
-        return move_value(_value - value);
+        return move_value(this->value() - value);
     }
 
     live_property &operator -=(const live_property &other)
     {
-        return operator -= (other._value);
+        return operator -= (other.value());
     }
 
     live_property &operator *=(const value_type &value)
     {
-        return move_value(_value * value);
+        return move_value(this->value() * value);
     }
 
     live_property &operator *=(const live_property &other)
     {
-        return operator *= (other._value);
+        return operator *= (other.value());
     }
 
     live_property &operator /=(const value_type &value)
     {
-        return move_value(_value / value);
+        return move_value(this->value() / value);
     }
 
     live_property &operator /=(const live_property &other)
     {
-        return operator /= (other._value);
+        return operator /= (other.value());
     }
 
     live_property &operator >>=(const value_type &value)
     {
-        return move_value(_value >> value);
+        return move_value(this->value() >> value);
     }
 
     live_property &operator >>=(const live_property &other)
     {
-        return operator >>= (other._value);
+        return operator >>= (other.value());
     }
 
     live_property &operator <<=(const value_type &value)
     {
-        return move_value(_value << value);
+        return move_value(this->value() << value);
     }
 
     live_property &operator <<=(const live_property &other)
     {
-        return operator <<= (other._value);
+        return operator <<= (other.value());
     }
 
     live_property &operator &=(const value_type &value)
     {
-        return move_value(_value & value);
+        return move_value(this->value() & value);
     }
 
     live_property &operator &=(const live_property &other)
     {
-        return operator &= (other._value);
+        return operator &= (other.value());
     }
 
     live_property &operator |=(const value_type &value)
     {
-        return move_value(_value | value);
+        return move_value(this->value() | value);
     }
 
     live_property &operator |=(const live_property &other)
     {
-        return operator |= (other._value);
+        return operator |= (other.value());
     }
 
     live_property &operator ^=(const value_type &value)
     {
-        return move_value(_value ^ value);
+        return move_value(this->value() ^ value);
     }
 
     live_property &operator ^=(const live_property &other)
     {
-        return operator ^= (other._value);
+        return operator ^= (other.value());
     }
 
     live_property &operator %=(const value_type &value)
     {
-        return move_value(_value % value);
+        return move_value(this->value() % value);
     }
 
     live_property &operator %=(const live_property &other)
     {
-        return operator %= (other._value);
+        return operator %= (other.value());
     }
 
     live_property &operator ++()
     {
-        auto value { _value };
+        auto value { this->value() };
 
-        if (emit_changing(++value))
-        {
-            ++_value;
-
-            emit_changed();
-        }
-
-        return *this;
+        return move_value(std::move(++value));
     }
 
     live_property operator ++(int)
     {
-        live_property return_value{ _name, _value };
+        live_property return_value{ _name, value() };
 
         return operator ++(), return_value;
     }
 
     live_property &operator --()
     {
-        auto value { _value };
-
-        if (emit_changing(--value))
-        {
-            --_value;
-
-            emit_changed();
-        }
+        auto value { this->value() };
 
-        return *this;
+        return move_value(std::move(--value));
     }
 
     live_property operator --(int)
     {
-        live_property return_value{ _name, _value };
+        live_property return_value{ _name, value() };
 
         return operator --(), return_value;
     }
@@ -238,8 +326,15 @@ public:
     nstd::signal_slot::signal<const live_property&> signal_value_changed {};
 
 private:
+    value_type &current_value()
+    {
+        return _pending ? *_pending : _value;
+    }
+
     live_property &assign_value(const value_type &value)
     {
+        if (auto transaction { live_property_transaction::current() }) return stage(*transaction, value_type { value });
+
         if (emit_changing(value))
         {
             _value = value;
@@ -252,6 +347,8 @@ private:
 
     live_property &move_value(value_type &&value)
     {
+        if (auto transaction { live_property_transaction::current() }) return stage(*transaction, std::forward<value_type>(value));
+
         if (emit_changing(value))
         {
             _value = std::forward<value_type>(value);
@@ -262,6 +359,35 @@ private:
         return *this;
     }
 
+    live_property &stage(live_property_transaction &transaction, value_type &&value)
+    {
+        if (!_pending)
+        {
+            transaction.enlist(this, &finish_pending);
+
+            _transaction = &transaction;
+        }
+
+        _pending = std::forward<value_type>(value);
+
+        return *this;
+    }
+
+    static void finish_pending(void *property, bool commit)
+    {
+        auto &self { *static_cast<live_property*>(property) };
+        auto value { std::move(*self._pending) };
+
+        self._pending.reset();
+        self._transaction = nullptr;
+
+        if (!commit) return;
+
+        if constexpr (std::equality_comparable<value_type>) if (value == self._value) return;
+
+        self.move_value(std::move(value));
+    }
+
     bool emit_changing(const value_type &value)
     {
         value_changing_context context{ *this, value };
@@ -278,6 +404,8 @@ private:
 
     std::u8string _name {};
     value_type _value {};
+    std::optional<value_type> _pending {};
+    live_property_transaction *_transaction { nullptr };
 };
 
 template<typename T>
@@ -595,4 +723,344 @@ private:
     value_type _value {};
     mutable std::recursive_mutex _lock {};
 };
+
+/**
+ * @brief Thread-safe live property of a trivially copyable type with lock-free reads
+ *
+ * Values fitting a lock-free std::atomic are kept in one; larger values are kept behind a
+ * sequence lock, which readers retry while a write is in progress. Writes are serialized by
+ * a recursive mutex and emit the changing/changed signals only if the value actually changes.
+ */
+template<typename T>
+requires std::is_trivially_copyable_v<T> && std::is_default_constructible_v<T>
+class live_property_ts<T>
+{
+public:
+    using value_type = T;
+
+    struct value_changing_context
+    {
+        const live_property_ts &property;
+        const value_type &new_value;
+        bool cancel = false;
+    };
+
+    live_property_ts(const std::u8string &name, const value_type &value = value_type()) :
+        signal_value_changing{ u8"/live_property_ts/"s + name + u8"/signal_value_changing"s },
+        signal_value_changed{ u8"/live_property_ts/"s + name + u8"/signal_value_changed"s },
+        _name{ name }, _value{ value }
+    {
+    }
+
+    live_property_ts(const live_property_ts &other) : _value{ other.value() }
+    {
+    }
+
+    live_property_ts(live_property_ts &&other) noexcept : _value{ other.value() }
+    {
+    }
+
+    live_property_ts &operator=(const live_property_ts &other)
+    {
+        return assign_value(other.value());
+    }
+
+    live_property_ts &operator=(live_property_ts &&other) noexcept
+    {
+        return assign_value(other.value());
+    }
+
+    live_property_ts &operator=(const value_type &value)
+    {
+        return assign_value(value);
+    }
+
+    std::u8string_view name() const
+    {
+        return _name;
+    }
+
+    value_type value() const
+    {
+        return _value.load();
+    }
+
+    operator value_type() const
+    {
+        return _value.load();
+    }
+
+    live_property_ts &operator +=(const value_type &value)
+    {
+        return update([&value](const value_type &current){ return static_cast<value_type>(current + value); });
+    }
+
+    live_property_ts &operator +=(const live_property_ts &other)
+    {
+        return operator += (other.value());
+    }
+
+    live_property_ts &operator -=(const value_type &value)
+    {
+        return update([&value](const value_type &current){ return static_cast<value_type>(current - value); });
+    }
+
+    live_property_ts &operator -=(const live_property_ts &other)
+    {
+        return operator -= (other.value());
+    }
+
+    live_property_ts &operator *=(const value_type &value)
+    {
+        return update([&value](const value_type &current){ return static_cast<value_type>(current * value); });
+    }
+
+    live_property_ts &operator *=(const live_property_ts &other)
+    {
+        return operator *= (other.value());
+    }
+
+    live_property_ts &operator /=(const value_type &value)
+    {
+        return update([&value](const value_type &current){ return static_cast<value_type>(current / value); });
+    }
+
+    live_property_ts &operator /=(const live_property_ts &other)
+    {
+        return operator /= (other.value());
+    }
+
+    live_property_ts &operator >>=(const value_type &value)
+    {
+        return update([&value](const value_type &current){ return static_cast<value_type>(current >> value); });
+    }
+
+    live_property_ts &operator >>=(const live_property_ts &other)
+    {
+        return operator >>= (other.value());
+    }
+
+    live_property_ts &operator <<=(const value_type &value)
+    {
+        return update([&value](const value_type &current){ return static_cast<value_type>(current << value); });
+    }
+
+    live_property_ts &operator <<=(const live_property_ts &other)
+    {
+        return operator <<= (other.value());
+    }
+
+    live_property_ts &operator &=(const value_type &value)
+    {
+        return update([&value](const value_type &current){ return static_cast<value_type>(current & value); });
+    }
+
+    live_property_ts &operator &=(const live_property_ts &other)
+    {
+        return operator &= (other.value());
+    }
+
+    live_property_ts &operator |=(const value_type &value)
+    {
+        return update([&value](const value_type &current){ return static_cast<value_type>(current | value); });
+    }
+
+    live_property_ts &operator |=(const live_property_ts &other)
+    {
+        return operator |= (other.value());
+    }
+
+    live_property_ts &operator ^=(const value_type &value)
+    {
+        return update([&value](const value_type &current){ return static_cast<value_type>(current ^ value); });
+    }
+
+    live_property_ts &operator ^=(const live_property_ts &other)
+    {
+        return operator ^= (other.value());
+    }
+
+    live_property_ts &operator %=(const value_type &value)
+    {
+        return update([&value](const value_type &current){ return static_cast<value_type>(current % value); });
+    }
+
+    live_property_ts &operator %=(const live_property_ts &other)
+    {
+        return operator %= (other.value());
+    }
+
+    live_property_ts &operator ++()
+    {
+        return update([](value_type current){ return ++current; });
+    }
+
+    live_property_ts operator ++(int)
+    {
+        std::scoped_lock lock { _write_lock };
+
+        live_property_ts return_value{ _name, value() };
+
+        return operator ++(), return_value;
+    }
+
+    live_property_ts &operator --()
+    {
+        return update([](value_type current){ return --current; });
+    }
+
+    live_property_ts operator --(int)
+    {
+        std::scoped_lock lock { _write_lock };
+
+        live_property_ts return_value{ _name, value() };
+
+        return operator --(), return_value;
+    }
+
+    nstd::signal_slot::signal<value_changing_context&> signal_value_changing {};
+    nstd::signal_slot::signal<const live_property_ts&> signal_value_changed {};
+
+private:
+    /**
+     * @brief Keeps the value in a lock-free std::atomic
+     */
+    class atomic_storage
+    {
+    public:
+        explicit atomic_storage(const value_type &value) noexcept : _value{ value } {}
+
+        value_type load() const noexcept
+        {
+            return _value.load(std::memory_order_acquire);
+        }
+
+        void store(const value_type &value) noexcept
+        {
+            _value.store(value, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<value_type> _value;
+    };
+
+    /**
+     * @brief Keeps the value in atomic words guarded by a sequence counter; stores must not run concurrently
+     */
+    class seqlock_storage
+    {
+    public:
+        explicit seqlock_storage(const value_type &value) noexcept
+        {
+            store_words(value);
+        }
+
+        value_type load() const noexcept
+        {
+            std::array<uint64_t, word_count> words;
+
+            for (;;)
+            {
+                auto sequence { _sequence.load(std::memory_order_acquire) };
+
+                if (sequence & 1)
+                {
+                    std::this_thread::yield();
+
+                    continue;
+                }
+
+                for (size_t word = 0; word < word_count; ++word) words[word] = _words[word].load(std::memory_order_relaxed);
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (_sequence.load(std::memory_order_relaxed) == sequence) break;
+            }
+
+            value_type value;
+
+            std::memcpy(&value, std::data(words), sizeof(value_type));
+
+            return value;
+        }
+
+        void store(const value_type &value) noexcept
+        {
+            auto sequence { _sequence.load(std::memory_order_relaxed) };
+
+            _sequence.store(sequence + 1, std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_release);
+
+            store_words(value);
+
+            _sequence.store(sequence + 2, std::memory_order_release);
+        }
+
+    private:
+        static constexpr size_t word_count { (sizeof(value_type) + sizeof(uint64_t) - 1) / sizeof(uint64_t) };
+
+        std::atomic_uint64_t _sequence { 0 };
+        std::array<std::atomic_uint64_t, word_count> _words {};
+
+        void store_words(const value_type &value) noexcept
+        {
+            std::array<uint64_t, word_count> words {};
+
+            std::memcpy(std::data(words), &value, sizeof(value_type));
+
+            for (size_t word = 0; word < word_count; ++word) _words[word].store(words[word], std::memory_order_relaxed);
+        }
+    };
+
+    using storage_type = std::conditional_t<std::atomic<value_type>::is_always_lock_free, atomic_storage, seqlock_storage>;
+
+    template<typename Functor>
+    live_property_ts &update(Functor &&functor)
+    {
+        std::scoped_lock lock { _write_lock };
+
+        return assign_value(functor(_value.load()));
+    }
+
+    live_property_ts &assign_value(const value_type &value)
+    {
+        std::scoped_lock lock { _write_lock };
+
+        if (equals(_value.load(), value)) return *this;
+
+        if (emit_changing(value))
+        {
+            _value.store(value);
+
+            emit_changed();
+        }
+
+        return *this;
+    }
+
+    static bool equals(const value_type &left, const value_type &right) noexcept
+    {
+        if constexpr (std::equality_comparable<value_type>) return left == right;
+        else return std::memcmp(&left, &right, sizeof(value_type)) == 0;
+    }
+
+    bool emit_changing(const value_type &value)
+    {
+        value_changing_context context{ *this, value };
+
+        signal_value_changing.emit(context);
+
+        return !context.cancel;
+    }
+
+    void emit_changed()
+    {
+        signal_value_changed.emit(*this);
+    }
+
+    std::u8string _name {};
+    storage_type _value { value_type {} };
+    mutable std::recursive_mutex _write_lock {};
+};
 }
@@ -20,17 +20,29 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <algorithm>
 #include <any>
+#include <array>
 #include <atomic>
+#include <bit>
 #include <chrono>
+#include <cmath>
 #include <concepts>
 #include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <exception>
 #include <functional>
 #include <iterator>
+#include <limits>
+#include <memory>
 #include <mutex>
-#include <set>
+#include <new>
+#include <optional>
 #include <shared_mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <thread>
@@ -38,7 +50,10 @@ SOFTWARE.
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
+#include "small_function.hpp"
+#include "timer_service.hpp"
 
 /**
  * @namespace nstd::signal_slot
@@ -90,6 +105,8 @@ using base_value_type = typename std::conditional_t<std::is_same_v<T1, std::void
  * 
  * This class is used to establish a bi-directional connection between two objects.
  * When one object is disconnected or destroyed, the other is automatically notified.
+ * The link is an atomic pointer, so one side may be tested while the other one is
+ * disconnected from another thread.
  * 
  * @tparam T1 Type of value stored in this paired_ptr instance
  * @tparam T2 Type of value stored in the connected paired_ptr instance
@@ -122,17 +139,17 @@ public:
      */
     paired_ptr(connected_paired_ptr_type *ptr) : _connected_paired_ptr{ ptr }
     {
-        if (_connected_paired_ptr) _connected_paired_ptr->_connected_paired_ptr = this;
+        if (ptr) ptr->_connected_paired_ptr.store(this, std::memory_order_release);
     }
 
     /**
      * @brief Move constructor
      * @param other The paired_ptr to move from
      */
-    paired_ptr(paired_ptr &&other) noexcept : paired_ptr{ other._connected_paired_ptr }
+    paired_ptr(paired_ptr &&other) noexcept : paired_ptr{ other._connected_paired_ptr.load(std::memory_order_acquire) }
     {
         base_type::operator=(static_cast<base_type&&>(std::forward<paired_ptr>(other)));
-        other._connected_paired_ptr = nullptr;
+        other._connected_paired_ptr.store(nullptr, std::memory_order_release);
     }
 
     paired_ptr(const paired_ptr &other) = delete;
@@ -145,17 +162,14 @@ public:
      */
     paired_ptr & operator=(paired_ptr &&other) noexcept
     {
-        if (_connected_paired_ptr)
-        {
-            if (other._connected_paired_ptr)
-                std::swap(_connected_paired_ptr->_connected_paired_ptr, other._connected_paired_ptr->_connected_paired_ptr);
-            else
-                _connected_paired_ptr->_connected_paired_ptr = &other;
-        }
-        else if (other._connected_paired_ptr)
-            other._connected_paired_ptr->_connected_paired_ptr = this;
+        auto connected { _connected_paired_ptr.load(std::memory_order_acquire) };
+        auto other_connected { other._connected_paired_ptr.load(std::memory_order_acquire) };
+
+        if (connected) connected->_connected_paired_ptr.store(&other, std::memory_order_release);
+        if (other_connected) other_connected->_connected_paired_ptr.store(this, std::memory_order_release);
 
-        std::swap(_connected_paired_ptr, other._connected_paired_ptr);
+        _connected_paired_ptr.store(other_connected, std::memory_order_release);
+        other._connected_paired_ptr.store(connected, std::memory_order_release);
 
         base_type::operator=(static_cast<base_type&&>(std::forward<paired_ptr>(other)));
 
@@ -185,10 +199,10 @@ public:
      */
     void disconnect() noexcept
     {
-        if (_connected_paired_ptr)
+        if (auto connected { _connected_paired_ptr.load(std::memory_order_acquire) })
         {
-            _connected_paired_ptr->_connected_paired_ptr = nullptr;
-            _connected_paired_ptr = nullptr;
+            connected->_connected_paired_ptr.store(nullptr, std::memory_order_release);
+            _connected_paired_ptr.store(nullptr, std::memory_order_release);
         }
     }
 
@@ -198,7 +212,7 @@ public:
      */
     const connected_paired_ptr_type * connected_ptr() const noexcept
     {
-        return _connected_paired_ptr;
+        return _connected_paired_ptr.load(std::memory_order_acquire);
     }
 
 
@@ -208,7 +222,7 @@ public:
      */
     operator bool() const noexcept
     {
-        return (_connected_paired_ptr);
+        return _connected_paired_ptr.load(std::memory_order_acquire) != nullptr;
     }
 
     /**
@@ -217,11 +231,11 @@ public:
      */
     bool operator!() const noexcept
     {
-        return !(_connected_paired_ptr);
+        return _connected_paired_ptr.load(std::memory_order_acquire) == nullptr;
     }
 
 protected:
-    connected_paired_ptr_type *_connected_paired_ptr = nullptr;
+    std::atomic<connected_paired_ptr_type*> _connected_paired_ptr { nullptr };
 };
 
 /**
@@ -233,7 +247,7 @@ protected:
 template<typename T1, typename T2>
 bool operator==(const paired_ptr<T1, T2> & lhs, const paired_ptr<T1, T2> & rhs)
 {
-    return lhs._connected_paired_ptr == rhs._connected_paired_ptr;
+    return lhs.connected_ptr() == rhs.connected_ptr();
 }
 
 /**
@@ -296,6 +310,18 @@ bool operator!=(std::nullptr_t, const paired_ptr<T1, T2> & rhs)
     return !(nullptr == rhs);
 }
 
+using nstd::small_function;
+using nstd::timer_service;
+
+/**
+ * @brief Stable handle of a connected slot
+ * 
+ * The lower 32 bits hold the index of the slot in its signal's slot index, the
+ * upper 32 bits hold the generation of that index entry. A handle of a slot that
+ * has been removed never matches a slot connected later at the same index.
+ */
+enum class slot_id : uint64_t { invalid = 0 };
+
 /**
  * @brief Base class for slots
  * 
@@ -305,23 +331,50 @@ bool operator!=(std::nullptr_t, const paired_ptr<T1, T2> & rhs)
 class slot_base
 {
 protected:
-    template<typename... Args> friend class signal;
+    template<typename Policy, typename... Args> friend class basic_signal;
+    template<typename... Args> friend class concurrent_signal;
 
     paired_ptr<> _connection {};
-    bool _enabled { true };
+    std::atomic_bool _enabled { true };
+    slot_id _id { slot_id::invalid };
 
 public:
+    /**
+     * @brief Default constructor
+     */
+    slot_base() = default;
+
+    /**
+     * @brief Move constructor
+     * @param other The slot to move from
+     */
+    slot_base(slot_base &&other) noexcept : _connection{ std::move(other._connection) }, _enabled{ other._enabled.load(std::memory_order_relaxed) }, _id{ other._id } {}
+
+    /**
+     * @brief Move assignment operator
+     * @param other The slot to move from
+     * @return Reference to this slot
+     */
+    slot_base &operator=(slot_base &&other) noexcept
+    {
+        _connection = std::move(other._connection);
+        _enabled.store(other._enabled.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        _id = other._id;
+
+        return *this;
+    }
+
     /**
      * @brief Sets whether the slot is enabled
      * @param is_enabled true to enable the slot, false to disable it
      */
-    void set_enabled(bool is_enabled) noexcept { _enabled = is_enabled; }
+    void set_enabled(bool is_enabled) noexcept { _enabled.store(is_enabled, std::memory_order_relaxed); }
     
     /**
      * @brief Checks if the slot is enabled
      * @return true if the slot is enabled, false otherwise
      */
-    bool is_enabled() const noexcept { return _enabled; }
+    bool is_enabled() const noexcept { return _enabled.load(std::memory_order_relaxed); }
     
     /**
      * @brief Checks if the slot is disconnected
@@ -333,396 +386,5129 @@ public:
      * @brief Disconnects the slot from its signal
      */
     void disconnect() noexcept { _connection.disconnect(); }
+
+    /**
+     * @brief Gets the handle of the slot
+     * @return The slot's handle
+     */
+    slot_id id() const noexcept { return _id; }
+
+    /**
+     * @brief Gets the slot a connection's paired_ptr is connected to
+     * 
+     * The connection's peer is the first member of a standard-layout slot_base, so
+     * the slot is reached without searching. The caller must prevent the slot from
+     * being moved or destroyed meanwhile.
+     * 
+     * @param con The connection to the slot
+     * @return Pointer to the slot if connected, nullptr otherwise
+     */
+    static const slot_base *from_connection(const paired_ptr<> &con) noexcept
+    {
+        return reinterpret_cast<const slot_base*>(con.connected_ptr());
+    }
 };
 
+static_assert(std::is_standard_layout_v<slot_base>);
+
 /**
- * @brief A slot that can be connected to a signal
+ * @brief Generation-checked table mapping slot handles to slot locations
  * 
- * A slot is essentially a wrapper around a function or method that can be
- * invoked when a signal is emitted.
+ * Lookup, insertion and removal are constant time. Released entries are reused
+ * with an incremented generation, so stale handles are rejected. The table is not
+ * synchronized; the owning signal guards it.
  * 
- * @tparam Args Types of arguments the slot accepts
+ * @tparam T Type of the location stored per slot
  */
-template<typename... Args>
-class slot : public slot_base
+template<typename T>
+class slot_index
 {
-protected:
-    std::function<void (Args...)> _functor {};
-    int64_t _priority{ 0 };
-
-    friend class connection;
-
 public:
     /**
-     * @brief Default constructor
+     * @brief Registers a new slot location
+     * @param value The location of the slot
+     * @return The handle of the slot
      */
-    slot() = default;
-    
+    slot_id acquire(const T &value)
+    {
+        uint32_t index;
+
+        if (!std::empty(_free_entries))
+        {
+            index = _free_entries.back();
+            _free_entries.pop_back();
+        }
+        else
+        {
+            index = static_cast<uint32_t>(std::size(_entries));
+            _entries.emplace_back();
+        }
+
+        auto &entry { _entries[index] };
+
+        entry.used = true;
+        entry.value = value;
+
+        return make_id(index, entry.generation);
+    }
+
     /**
-     * @brief Constructor with a function and priority
-     * @param f Function to be called when the slot is invoked
-     * @param priority Priority of the slot (lower value means higher priority; slots with lower priority values are called first)
+     * @brief Unregisters a slot and invalidates its handle
+     * @param id The handle of the slot
      */
-    slot(std::function<void(Args...)>&& f, int64_t priority = 0) : _functor{ std::forward<std::function<void(Args...)>>(f) }, _priority{ priority } {}
-    
+    void release(slot_id id)
+    {
+        if (auto entry { find_entry(id) }; entry != nullptr)
+        {
+            entry->used = false;
+            entry->value = {};
+
+            if (++entry->generation == 0) entry->generation = 1;
+
+            _free_entries.push_back(index_of(id));
+        }
+    }
+
     /**
-     * @brief Invokes the slot with the given arguments
-     * @param args Arguments to pass to the slot function
+     * @brief Finds the location of a slot
+     * @param id The handle of the slot
+     * @return Pointer to the location if the handle is valid, nullptr otherwise
      */
-    void invoke(const Args &... args) const { _functor(args...); }
-    
+    T *find(slot_id id) noexcept
+    {
+        auto entry { find_entry(id) };
+
+        return entry ? &entry->value : nullptr;
+    }
+
     /**
-     * @brief Function call operator to invoke the slot
-     * @param args Arguments to pass to the slot function
+     * @brief Finds the location of a slot
+     * @param id The handle of the slot
+     * @return Pointer to the location if the handle is valid, nullptr otherwise
      */
-    void operator()(const Args &... args) const { invoke(args...); }
-    
+    const T *find(slot_id id) const noexcept
+    {
+        return const_cast<slot_index*>(this)->find(id);
+    }
+
     /**
-     * @brief Gets the priority of the slot
-     * @return The slot's priority
+     * @brief Invalidates all handles
      */
-    int64_t get_priority() const noexcept { return _priority; }
-    
+    void clear()
+    {
+        _free_entries.clear();
+
+        for (uint32_t index = 0; index < std::size(_entries); ++index)
+        {
+            auto &entry { _entries[index] };
+
+            if (entry.used)
+            {
+                entry.used = false;
+                entry.value = {};
+
+                if (++entry.generation == 0) entry.generation = 1;
+            }
+
+            _free_entries.push_back(index);
+        }
+    }
+
+private:
+    struct entry_type
+    {
+        uint32_t generation { 1 };
+        bool used { false };
+        T value {};
+    };
+
+    std::vector<entry_type> _entries {};
+    std::vector<uint32_t> _free_entries {};
+
+    static slot_id make_id(uint32_t index, uint32_t generation) noexcept
+    {
+        return static_cast<slot_id>((static_cast<uint64_t>(generation) << 32) | index);
+    }
+
+    static uint32_t index_of(slot_id id) noexcept
+    {
+        return static_cast<uint32_t>(static_cast<uint64_t>(id));
+    }
+
+    static uint32_t generation_of(slot_id id) noexcept
+    {
+        return static_cast<uint32_t>(static_cast<uint64_t>(id) >> 32);
+    }
+
+    entry_type *find_entry(slot_id id) noexcept
+    {
+        auto index { index_of(id) };
+
+        if (id == slot_id::invalid || index >= std::size(_entries)) return nullptr;
+
+        auto &entry { _entries[index] };
+
+        return (entry.used && entry.generation == generation_of(id)) ? &entry : nullptr;
+    }
+};
+
+/**
+ * @brief Storage keeping objects at stable addresses
+ *
+ * Objects are constructed in chunks that are neither moved nor freed before the
+ * pool is destroyed, and the storage of destroyed objects is reused by later
+ * constructions. A connection refers to its slot through a paired_ptr and may be
+ * disconnected from any thread, so a connected slot must never move. Objects still
+ * alive are destroyed with the pool. The pool is not synchronized; its owner guards it.
+ *
+ * @tparam T Type of the stored objects
+ * @tparam ChunkSize Number of objects allocated at once
+ */
+template<typename T, size_t ChunkSize = 16>
+class stable_pool
+{
+public:
+    stable_pool() = default;
+    stable_pool(const stable_pool &other) = delete;
+    stable_pool &operator=(const stable_pool &other) = delete;
+
     /**
-     * @brief Sets the priority of the slot
-     * @param priority New priority value
-     * @return The previous priority value
+     * @brief Move constructor; the objects stay where they are
+     * @param other The pool to move from
      */
-    int64_t set_priority(int64_t priority) noexcept { std::swap(_priority, priority); return priority; }
+    stable_pool(stable_pool &&other) noexcept : _chunks{ std::move(other._chunks) }, _free{ std::exchange(other._free, nullptr) } {}
 
     /**
-     * @brief Compares this slot with a paired_ptr
-     * @param s The paired_ptr to compare with
-     * @return true if this slot is connected to the given paired_ptr
+     * @brief Move assignment operator destroying the objects of this pool
+     * @param other The pool to move from
+     * @return Reference to this pool
      */
-    bool operator == (const paired_ptr<> &s) const noexcept
+    stable_pool &operator=(stable_pool &&other) noexcept
     {
-        return &_connection == s.connected_ptr();
+        if (this != &other)
+        {
+            destroy_all();
+
+            _chunks = std::move(other._chunks);
+            _free = std::exchange(other._free, nullptr);
+        }
+
+        return *this;
     }
 
-    /**
-     * @brief Compares this slot with another slot
-     * @param s The slot to compare with
-     * @return true if both slots have the same connection
-     */
-    bool operator == (const slot &s) const noexcept
+    ~stable_pool()
     {
-        return operator ==(s._connection);
+        destroy_all();
     }
 
     /**
-     * @brief Less-than comparison based on priority
-     * @param s The slot to compare with
-     * @return true if this slot has lower priority than the given slot
+     * @brief Constructs an object
+     * @param args Arguments to construct the object from
+     * @return Pointer to the object
      */
-    bool operator < (const slot& s) const noexcept
+    template<typename... CArgs>
+    T *create(CArgs &&... args)
     {
-        return _priority < s._priority;
+        if (!_free) grow();
+
+        auto storage { _free };
+
+        _free = storage->next;
+
+        try
+        {
+            auto object { ::new (static_cast<void*>(storage->bytes)) T(std::forward<CArgs>(args)...) };
+
+            storage->used = true;
+
+            return object;
+        }
+        catch(...)
+        {
+            storage->next = _free;
+            _free = storage;
+
+            throw;
+        }
     }
 
     /**
-     * @brief Greater-than comparison based on priority
-     * @param s The slot to compare with
-     * @return true if this slot has higher priority than the given slot
+     * @brief Destroys an object created by this pool
+     * @param object The object
      */
-    bool operator > (const slot& s) const noexcept
+    void destroy(T *object) noexcept
     {
-        return _priority > s._priority;
+        auto storage { reinterpret_cast<node*>(object) };
+
+        object->~T();
+
+        storage->used = false;
+        storage->next = _free;
+        _free = storage;
+    }
+
+private:
+    struct node
+    {
+        alignas(T) std::byte bytes[sizeof(T)];
+        node *next;
+        bool used;
+    };
+
+    std::vector<std::unique_ptr<node[]>> _chunks {};
+    node *_free { nullptr };
+
+    void grow()
+    {
+        auto &chunk { _chunks.emplace_back(std::make_unique_for_overwrite<node[]>(ChunkSize)) };
+
+        for (size_t index = ChunkSize; index-- > 0;)
+        {
+            chunk[index].used = false;
+            chunk[index].next = _free;
+            _free = &chunk[index];
+        }
+    }
+
+    void destroy_all() noexcept
+    {
+        for (auto &chunk : _chunks)
+        {
+            for (size_t index = 0; index < ChunkSize; ++index)
+            {
+                if (chunk[index].used) std::launder(reinterpret_cast<T*>(chunk[index].bytes))->~T();
+            }
+        }
+
+        _chunks.clear();
+        _free = nullptr;
     }
 };
 
 /**
- * @brief Base interface class for all signals
- * 
- * Provides a common interface for all signal types.
+ * @brief Tag type selecting the batch-aware slot constructor
  */
-class signal_base
+struct batch_slot_t
+{
+    explicit batch_slot_t() = default;
+};
+
+/**
+ * @brief Tag selecting the batch-aware slot constructor
+ */
+inline constexpr batch_slot_t batch_slot {};
+
+/**
+ * @brief A task run by an executor
+ */
+using async_task = small_function<void()>;
+
+/**
+ * @brief Type-erased executor that runs tasks, e.g. by posting them to a thread pool
+ */
+using executor_type = std::function<void(async_task &&)>;
+
+/**
+ * @brief Makes an executor posting tasks to a pool with an enqueue member function, such as nstd::thread_pool
+ * @param pool The pool; it must outlive the executor
+ * @return The executor
+ */
+template<typename Pool>
+executor_type make_executor(Pool &pool)
+{
+    return [&pool](async_task &&task){ pool.enqueue([task = std::move(task)]() mutable { task(); }); };
+}
+
+/**
+ * @brief Where a slot runs when its signal is emitted with emit_async
+ */
+enum class slot_affinity
+{
+    caller,   ///< On the emitting thread
+    executor, ///< On the signal's executor, or on the emitting thread if the signal has none
+    strand    ///< On the strand given on connect, serialized with its other tasks
+};
+
+/**
+ * @brief Runs tasks one at a time, in the order they were posted, on an executor
+ *
+ * At most one task of a strand is queued on the executor at any time; it runs the
+ * posted tasks until the strand is empty. The destructor waits for the posted tasks.
+ */
+class strand
 {
 public:
     /**
-     * @brief Virtual destructor for proper inheritance
-     */
-    virtual ~signal_base() = default;
-    
-    /**
-     * @brief Gets the name of the signal
-     * @return The signal's name
+     * @brief Constructor
+     * @param executor The executor running the tasks; tasks run on the posting thread if it is empty
      */
-    [[nodiscard]] virtual std::u8string_view name() const = 0;
-    
+    explicit strand(executor_type executor = {}) : _executor{ std::move(executor) } {}
+
+    strand(const strand &other) = delete;
+    strand &operator=(const strand &other) = delete;
+
     /**
-     * @brief Sets whether the signal is enabled
-     * @param enabled true to enable the signal, false to disable it
+     * @brief Destructor that waits until the posted tasks have run
      */
-    virtual void set_enabled(bool enabled) = 0;
-    
+    ~strand()
+    {
+        std::unique_lock lock(_lock);
+
+        _idle_cv.wait(lock, [this]{ return !_running; });
+    }
+
     /**
-     * @brief Checks if the signal is enabled
-     * @return true if the signal is enabled, false otherwise
+     * @brief Posts a task
+     * @param task The task to run after all tasks posted before it
      */
-    virtual bool is_enabled() const = 0;
-    
+    void post(async_task &&task)
+    {
+        {
+            std::scoped_lock lock(_lock);
+
+            _tasks.push_back(std::move(task));
+
+            if (std::exchange(_running, true)) return;
+        }
+
+        if (_executor) _executor([this]{ drain(); });
+        else drain();
+    }
+
     /**
-     * @brief Gets the number of slots connected to the signal
-     * @return Number of connected slots
+     * @brief Gets an executor posting to this strand
+     * @return The executor; the strand must outlive it
      */
-    [[nodiscard]] virtual size_t size() const = 0;
-    
+    executor_type executor() noexcept
+    {
+        return [this](async_task &&task){ post(std::move(task)); };
+    }
+
     /**
-     * @brief Gets the signal's payload
-     * @return Reference to the signal's payload
+     * @brief Checks whether the strand runs on the calling thread
+     * @return true if called from a task of this strand, false otherwise
      */
-    [[nodiscard]] virtual std::any &payload() = 0;
+    bool running_in_this_thread() const noexcept
+    {
+        return _current_strand == this;
+    }
+
+private:
+    static inline thread_local const strand *_current_strand { nullptr };
+
+    executor_type _executor {};
+    std::deque<async_task> _tasks {};
+    bool _running { false };
+    std::mutex _lock {};
+    std::condition_variable _idle_cv {};
+
+    void drain()
+    {
+        auto previous_strand { std::exchange(_current_strand, this) };
+
+        while (true)
+        {
+            async_task task;
+
+            {
+                std::scoped_lock lock(_lock);
+
+                if (std::empty(_tasks))
+                {
+                    _running = false;
+                    _idle_cv.notify_all();
+
+                    break;
+                }
+
+                task = std::move(_tasks.front());
+
+                _tasks.pop_front();
+            }
+
+            task();
+        }
+
+        _current_strand = previous_strand;
+    }
+};
+
+/**
+ * @brief Runs tasks one at a time, in the order they were posted, on a thread running an event loop
+ *
+ * Posted tasks are queued until the loop calls run_pending, which runs all of them in a
+ * batch. The strand does not own a thread: posting the first task after a batch calls
+ * the wake functor, once per batch, so the loop can be woken through whatever it waits
+ * on, e.g. by writing to an eventfd or a self-pipe watched by poll, or by posting to a
+ * GUI event queue. Loops without such a primitive can block in wait_for instead.
+ */
+class event_loop_strand
+{
+public:
+    using wake_functor = std::function<void()>;
+
+    /**
+     * @brief Constructor
+     * @param wake Function waking the loop; it may be called from any thread, but never while the strand is locked
+     */
+    explicit event_loop_strand(wake_functor wake = {}) : _wake{ std::move(wake) } {}
+
+    event_loop_strand(const event_loop_strand &other) = delete;
+    event_loop_strand &operator=(const event_loop_strand &other) = delete;
+
+    /**
+     * @brief Posts a task
+     * @param task The task to run on the loop after all tasks posted before it
+     */
+    void post(async_task &&task)
+    {
+        bool wake { false };
+
+        {
+            std::scoped_lock lock(_lock);
+
+            _tasks.push_back(std::move(task));
+
+            wake = !std::exchange(_wake_pending, true);
+        }
+
+        if (!wake) return;
+
+        _ready_cv.notify_one();
+
+        if (_wake) _wake();
+    }
+
+    /**
+     * @brief Gets an executor posting to this strand
+     * @return The executor; the strand must outlive it
+     */
+    executor_type executor() noexcept
+    {
+        return [this](async_task &&task){ post(std::move(task)); };
+    }
+
+    /**
+     * @brief Runs the tasks posted so far; called by the loop
+     *
+     * Tasks posted while the batch runs are left for the next call, after another wakeup.
+     * If a task throws, the tasks after it stay queued, the loop is woken again and the
+     * exception is rethrown. Calls from a task of the strand do nothing.
+     *
+     * @return Number of tasks run
+     */
+    size_t run_pending()
+    {
+        if (running_in_this_thread()) return 0;
+
+        std::vector<async_task> batch;
+
+        {
+            std::scoped_lock lock(_lock);
+
+            batch.swap(_tasks);
+
+            _wake_pending = false;
+        }
+
+        auto previous_strand { std::exchange(_current_strand, this) };
+        size_t position { 0 };
+
+        try
+        {
+            for (; position < std::size(batch); ++position) batch[position]();
+        }
+        catch (...)
+        {
+            _current_strand = previous_strand;
+
+            bool wake { false };
+
+            {
+                std::scoped_lock lock(_lock);
+
+                _tasks.insert(std::begin(_tasks), std::make_move_iterator(std::begin(batch) + static_cast<std::ptrdiff_t>(position) + 1), std::make_move_iterator(std::end(batch)));
+
+                wake = _wake_pending = !std::empty(_tasks);
+            }
+
+            if (wake && _wake) _wake();
+
+            throw;
+        }
+
+        _current_strand = previous_strand;
+
+        return position;
+    }
+
+    /**
+     * @brief Blocks until a task is posted or the timeout expires
+     * @param timeout The longest time to wait
+     * @return true if tasks are pending, false otherwise
+     */
+    template<typename Duration>
+    bool wait_for(const Duration &timeout)
+    {
+        std::unique_lock lock(_lock);
+
+        return _ready_cv.wait_for(lock, timeout, [this]{ return !std::empty(_tasks); });
+    }
+
+    /**
+     * @brief Gets the number of pending tasks
+     * @return Number of tasks posted and not run yet
+     */
+    size_t size() const
+    {
+        std::scoped_lock lock(_lock);
+
+        return std::size(_tasks);
+    }
+
+    /**
+     * @brief Checks whether the strand runs on the calling thread
+     * @return true if called from a task of this strand, false otherwise
+     */
+    bool running_in_this_thread() const noexcept
+    {
+        return _current_strand == this;
+    }
+
+private:
+    static inline thread_local const event_loop_strand *_current_strand { nullptr };
+
+    wake_functor _wake {};
+    std::vector<async_task> _tasks {};
+    bool _wake_pending { false };
+    mutable std::mutex _lock {};
+    std::condition_variable _ready_cv {};
+};
+
+/**
+ * @brief Completion handle of an emit_async call
+ *
+ * The handle is done once every slot of the emission has run. An exception thrown by a
+ * slot does not stop the other slots; the first one is rethrown by wait.
+ */
+class async_emission
+{
+public:
+    /**
+     * @brief Checks whether all slots of the emission have run
+     * @return true if the emission is complete, false otherwise
+     */
+    [[nodiscard]] bool done() const noexcept
+    {
+        return !_state || _state->pending.load() == 0;
+    }
+
+    /**
+     * @brief Waits until all slots of the emission have run
+     *
+     * Must not be called from a slot of the same emission.
+     */
+    void wait() const
+    {
+        if (!_state) return;
+
+        for (auto pending { _state->pending.load() }; pending > 0; pending = _state->pending.load()) _state->pending.wait(pending);
+
+        if (_state->exception) std::rethrow_exception(_state->exception);
+    }
+
+    /**
+     * @brief Same as wait
+     */
+    void join() const
+    {
+        wait();
+    }
+
+protected:
+    template<typename... Args> friend class slot;
+    template<typename Policy, typename... Args> friend class basic_signal;
+    template<typename... Args> friend class concurrent_signal;
+
+    struct state
+    {
+        std::atomic_size_t pending { 0 };
+        std::atomic_flag failed {};
+        std::exception_ptr exception {};
+    };
+
+    std::shared_ptr<state> _state {};
+
+    /**
+     * @brief Runs a task of the emission on the calling thread
+     */
+    template<typename Task>
+    void run(Task &&task)
+    {
+        try
+        {
+            task();
+        }
+        catch (...)
+        {
+            fail(get_state());
+        }
+    }
+
+    /**
+     * @brief Posts a task of the emission to an executor or a strand
+     * @param target The executor or strand; the task runs on the calling thread if it is an empty executor
+     * @param task The task
+     */
+    template<typename Target, typename Task>
+    void post(Target &target, Task &&task)
+    {
+        auto &current_state { get_state() };
+
+        ++current_state.pending;
+
+        async_task wrapper { [state = _state, task = std::forward<Task>(task)]() mutable
+        {
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                fail(*state);
+            }
+
+            if (--state->pending == 0) state->pending.notify_all();
+        } };
+
+        if constexpr (std::is_same_v<Target, strand>) target.post(std::move(wrapper));
+        else if (target) target(std::move(wrapper));
+        else wrapper();
+    }
+
+    state &get_state()
+    {
+        if (!_state) _state = std::make_shared<state>();
+
+        return *_state;
+    }
+
+    static void fail(state &s) noexcept
+    {
+        if (!s.failed.test_and_set()) s.exception = std::current_exception();
+    }
+};
+
+/**
+ * @brief A slot that can be connected to a signal
+ * 
+ * A slot is essentially a wrapper around a function or method that can be
+ * invoked when a signal is emitted.
+ * 
+ * @tparam Args Types of arguments the slot accepts
+ */
+template<typename... Args>
+class slot : public slot_base
+{
+protected:
+    small_function<void (const Args &...)> _functor {};
+    small_function<void (std::span<const std::tuple<Args...>>), 16> _batch_functor {};
+    std::shared_ptr<const small_function<void (const Args &...)>> _shared_functor {};
+    strand *_strand { nullptr };
+    int64_t _priority{ 0 };
+    slot_affinity _affinity { slot_affinity::caller };
+    bool _consuming { false };
+
+    friend class connection;
+
+    /**
+     * @brief Checks if a function can only take the arguments by rvalue
+     */
+    template<typename Functor>
+    static constexpr bool is_consuming_v { !std::invocable<std::decay_t<Functor>&, const Args &...> && std::invocable<std::decay_t<Functor>&, Args &&...> };
+
+    /**
+     * @brief Adapts a function to the stored signature
+     * 
+     * A consuming function gets the arguments moved to it; its callers must pass
+     * objects that may be moved from.
+     * 
+     * @param f The function to adapt
+     * @return The stored function
+     */
+    template<typename Functor>
+    static small_function<void (const Args &...)> make_functor(Functor &&f)
+    {
+        if constexpr (is_consuming_v<Functor>)
+            return [f = std::forward<Functor>(f)](const Args &... args) mutable { std::invoke(f, std::move(const_cast<Args&>(args))...); };
+        else
+            return std::forward<Functor>(f);
+    }
+
+public:
+    using batch_type = std::span<const std::tuple<Args...>>;
+
+    /**
+     * @brief Default constructor
+     */
+    slot() = default;
+    
+    /**
+     * @brief Constructor with a function and priority
+     * 
+     * Callables of up to 48 bytes are stored inline, without a heap allocation.
+     * A function that can only take the arguments by rvalue, such as one taking a
+     * std::unique_ptr, consumes them: it gets the emitted objects when it is the last
+     * slot of an rvalue emission and its own copy otherwise. It is skipped if the
+     * arguments cannot be copied.
+     * 
+     * @param f Function to be called when the slot is invoked
+     * @param priority Priority of the slot (lower value means higher priority; slots with lower priority values are called first)
+     */
+    template<typename Functor>
+    requires std::invocable<std::decay_t<Functor>&, const Args &...> || std::invocable<std::decay_t<Functor>&, Args &&...>
+    slot(Functor &&f, int64_t priority = 0) : _functor{ make_functor(std::forward<Functor>(f)) }, _priority{ priority }, _consuming{ is_consuming_v<Functor> } {}
+
+    /**
+     * @brief Constructor with a batch-aware function and priority
+     * 
+     * The function receives whole batches of emissions as a span of argument tuples.
+     * Single emissions are delivered as a batch of one.
+     * 
+     * @param f Function to be called with a batch of emissions
+     * @param priority Priority of the slot (lower value means higher priority; slots with lower priority values are called first)
+     */
+    template<typename Functor>
+    requires std::invocable<std::decay_t<Functor>&, batch_type>
+    slot(batch_slot_t, Functor &&f, int64_t priority = 0) : _batch_functor{ std::forward<Functor>(f) }, _priority{ priority }
+    {
+        static_assert(std::is_copy_constructible_v<std::tuple<Args...>>, "Batch-aware slots require copyable arguments");
+    }
+
+    /**
+     * @brief Constructor with a function, its affinity for emit_async and priority
+     * 
+     * The function is shared with the tasks of emit_async, so it may run after the slot
+     * has been moved or disconnected.
+     * 
+     * @param f Function to be called when the slot is invoked
+     * @param affinity Where the function runs on emit_async
+     * @param s The strand to run on if the affinity is slot_affinity::strand
+     * @param priority Priority of the slot (lower value means higher priority; slots with lower priority values are called first)
+     */
+    template<typename Functor>
+    requires std::invocable<std::decay_t<Functor>&, const Args &...>
+    slot(Functor &&f, slot_affinity affinity, strand *s, int64_t priority = 0) : _priority{ priority }, _affinity{ affinity == slot_affinity::strand && !s ? slot_affinity::executor : affinity }
+    {
+        if (_affinity == slot_affinity::caller)
+        {
+            _functor = std::forward<Functor>(f);
+
+            return;
+        }
+
+        _shared_functor = std::make_shared<const small_function<void (const Args &...)>>(std::forward<Functor>(f));
+        _functor = [functor = _shared_functor](const Args &... args){ (*functor)(args...); };
+        _strand = s;
+    }
     
     /**
-     * @brief Enables or disables a slot
-     * @param slot The slot to enable/disable
-     * @param enabled true to enable the slot, false to disable it
+     * @brief Invokes the slot with the given arguments
+     * @param args Arguments to pass to the slot function
+     */
+    void invoke(const Args &... args) const
+    {
+        if constexpr (std::is_copy_constructible_v<std::tuple<Args...>>)
+        {
+            if (_consuming)
+            {
+                std::tuple<Args...> item { args... };
+
+                std::apply(_functor, item);
+            }
+            else if (_functor) _functor(args...);
+            else
+            {
+                const std::tuple<Args...> item { args... };
+
+                _batch_functor(batch_type{ &item, 1 });
+            }
+        }
+        else if (!_consuming && _functor) _functor(args...);
+    }
+
+    /**
+     * @brief Invokes the slot with arguments it may move from
+     * 
+     * Used for the last slot of an rvalue emission: a consuming slot gets the
+     * arguments by rvalue, any other slot as by invoke.
+     * 
+     * @param args Arguments to pass to the slot function
+     */
+    void consume(Args &... args) const
+    {
+        if (_consuming) _functor(args...);
+        else invoke(args...);
+    }
+
+    /**
+     * @brief Invokes the slot with a batch of emissions
+     * 
+     * A batch-aware slot receives the whole span. Any other slot is invoked once per
+     * item, stopping early if it gets disabled or disconnected meanwhile.
+     * 
+     * @param batch The argument tuples of the emissions
+     */
+    void invoke_batch(batch_type batch) const
+    {
+        if (_batch_functor)
+        {
+            _batch_functor(batch);
+
+            return;
+        }
+
+        for (auto &&item : batch)
+        {
+            if (is_disconnected() || !is_enabled()) break;
+
+            std::apply([this](const Args &... args){ invoke(args...); }, item);
+        }
+    }
+
+    /**
+     * @brief Invokes the slot as part of an asynchronous emission
+     * 
+     * The slot runs on its strand, on the executor, or on the calling thread, depending
+     * on its affinity.
+     * 
+     * @param completion The completion handle of the emission
+     * @param executor The executor of the signal
+     * @param args The shared arguments of the emission
+     */
+    void invoke_async(async_emission &completion, const executor_type &executor, const std::shared_ptr<const std::tuple<Args...>> &args) const
+    {
+        if (!_shared_functor)
+        {
+            completion.run([this, &args]{ std::apply([this](const Args &... a){ invoke(a...); }, *args); });
+
+            return;
+        }
+
+        auto task { [functor = _shared_functor, args]{ std::apply(*functor, *args); } };
+
+        if (_affinity == slot_affinity::strand) completion.post(*_strand, std::move(task));
+        else completion.post(executor, std::move(task));
+    }
+
+    /**
+     * @brief Gets where the slot runs on emit_async
+     * @return The slot's affinity
+     */
+    slot_affinity get_affinity() const noexcept { return _affinity; }
+
+    /**
+     * @brief Checks if the slot accepts whole batches of emissions
+     * @return true if the slot is batch-aware, false otherwise
+     */
+    bool is_batch_aware() const noexcept { return static_cast<bool>(_batch_functor); }
+    
+    /**
+     * @brief Function call operator to invoke the slot
+     * @param args Arguments to pass to the slot function
+     */
+    void operator()(const Args &... args) const { invoke(args...); }
+    
+    /**
+     * @brief Gets the priority of the slot
+     * @return The slot's priority
+     */
+    int64_t get_priority() const noexcept { return _priority; }
+    
+    /**
+     * @brief Sets the priority of the slot
+     * @param priority New priority value
+     * @return The previous priority value
+     */
+    int64_t set_priority(int64_t priority) noexcept { std::swap(_priority, priority); return priority; }
+
+    /**
+     * @brief Compares this slot with a paired_ptr
+     * @param s The paired_ptr to compare with
+     * @return true if this slot is connected to the given paired_ptr
+     */
+    bool operator == (const paired_ptr<> &s) const noexcept
+    {
+        return &_connection == s.connected_ptr();
+    }
+
+    /**
+     * @brief Compares this slot with another slot
+     * @param s The slot to compare with
+     * @return true if both slots have the same connection
+     */
+    bool operator == (const slot &s) const noexcept
+    {
+        return operator ==(s._connection);
+    }
+
+    /**
+     * @brief Less-than comparison based on priority
+     * @param s The slot to compare with
+     * @return true if this slot has lower priority than the given slot
+     */
+    bool operator < (const slot& s) const noexcept
+    {
+        return _priority < s._priority;
+    }
+
+    /**
+     * @brief Greater-than comparison based on priority
+     * @param s The slot to compare with
+     * @return true if this slot has higher priority than the given slot
+     */
+    bool operator > (const slot& s) const noexcept
+    {
+        return _priority > s._priority;
+    }
+};
+
+/**
+ * @brief A lock-free histogram of latencies with logarithmic buckets
+ * 
+ * Values are bucketed in the manner of HDR histograms: every power of two is split into
+ * 16 linear sub-buckets, so a value is known to within 6.25%. Values of up to 2^44 are
+ * told apart, larger ones share the last bucket. Recording takes a few relaxed atomic
+ * operations and may run concurrently with other recordings and with reads.
+ */
+class latency_histogram
+{
+public:
+    static constexpr size_t sub_bucket_bits { 4 };
+    static constexpr size_t sub_bucket_count { size_t { 1 } << sub_bucket_bits };
+    static constexpr size_t octave_count { 41 };
+    static constexpr size_t bucket_count { sub_bucket_count * octave_count };
+
+    /**
+     * @brief Records a value
+     * @param value The value, e.g. a duration in nanoseconds
+     */
+    void record(uint64_t value) noexcept
+    {
+        _buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+        _count.fetch_add(1, std::memory_order_relaxed);
+        _sum.fetch_add(value, std::memory_order_relaxed);
+
+        for (auto min { _min.load(std::memory_order_relaxed) }; value < min && !_min.compare_exchange_weak(min, value, std::memory_order_relaxed););
+        for (auto max { _max.load(std::memory_order_relaxed) }; value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed););
+    }
+
+    uint64_t count() const noexcept { return _count.load(std::memory_order_relaxed); }
+    uint64_t sum() const noexcept { return _sum.load(std::memory_order_relaxed); }
+    uint64_t min() const noexcept { return count() ? _min.load(std::memory_order_relaxed) : 0; }
+    uint64_t max() const noexcept { return _max.load(std::memory_order_relaxed); }
+    uint64_t mean() const noexcept { auto n { count() }; return n ? sum() / n : 0; }
+
+    /**
+     * @brief Gets a percentile of the recorded values
+     * @param percentile The percentile, from 0 to 100
+     * @return The highest value of the bucket holding the percentile, or zero if nothing was recorded
+     */
+    uint64_t percentile(double percentile) const noexcept
+    {
+        std::array<uint64_t, bucket_count> counts;
+        uint64_t total { 0 };
+
+        for (size_t bucket = 0; bucket < bucket_count; ++bucket) total += counts[bucket] = _buckets[bucket].load(std::memory_order_relaxed);
+
+        if (total == 0) return 0;
+
+        auto rank { std::clamp<uint64_t>(static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0 * total)), 1, total) };
+
+        for (size_t bucket = 0, seen = 0; bucket < bucket_count; ++bucket)
+        {
+            if ((seen += counts[bucket]) >= rank) return bucket + 1 < bucket_count ? std::min(highest_of(bucket), max()) : max();
+        }
+
+        return max();
+    }
+
+private:
+    std::array<std::atomic_uint64_t, bucket_count> _buckets {};
+    std::atomic_uint64_t _count { 0 }, _sum { 0 }, _min { std::numeric_limits<uint64_t>::max() }, _max { 0 };
+
+    static size_t bucket_of(uint64_t value) noexcept
+    {
+        if (value < sub_bucket_count) return static_cast<size_t>(value);
+
+        auto octave { static_cast<size_t>(std::bit_width(value)) - sub_bucket_bits };
+
+        if (octave >= octave_count) return bucket_count - 1;
+
+        return octave * sub_bucket_count + static_cast<size_t>(value >> (octave - 1)) - sub_bucket_count;
+    }
+
+    static uint64_t highest_of(size_t bucket) noexcept
+    {
+        if (bucket < sub_bucket_count) return bucket;
+
+        auto octave { bucket / sub_bucket_count }, sub_bucket { bucket % sub_bucket_count };
+
+        return ((uint64_t { sub_bucket_count + sub_bucket } + 1) << (octave - 1)) - 1;
+    }
+};
+
+/**
+ * @brief The metrics of an instrumented signal
+ * 
+ * Counters and latencies are recorded by the signal. Gauges, such as the depth of a
+ * signal's queue, are functions read when the metrics are reported; the signal removes
+ * them when it is destroyed, while the metrics may outlive it. Gauges are guarded by a
+ * lock of their own, so they may take the signal's locks while slots are being timed.
+ */
+class signal_metrics
+{
+public:
+    using gauge_type = std::function<uint64_t()>;
+
+    /**
+     * @brief The gauges a signal can publish
+     */
+    enum class gauge
+    {
+        queue_depth, ///< Number of queued emissions
+        dropped,     ///< Number of emissions dropped by the overflow policy
+        coalesced    ///< Number of emissions merged into queued ones
+    };
+
+    static constexpr size_t gauge_count { 3 };
+
+    /**
+     * @brief Gets the name of the signal
+     * @return The name
+     */
+    std::u8string name() const
+    {
+        std::shared_lock lock(_lock);
+
+        return _name;
+    }
+
+    /**
+     * @brief Sets the name of the signal
+     * @param name The name
+     */
+    void set_name(const std::u8string &name)
+    {
+        std::unique_lock lock(_lock);
+
+        _name = name;
+    }
+
+    /**
+     * @brief Counts emissions
+     * @param count Number of emissions
+     */
+    void count_emissions(uint64_t count) noexcept
+    {
+        _emissions.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the number of emissions
+     * @return Number of emissions
+     */
+    uint64_t get_emission_count() const noexcept
+    {
+        return _emissions.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the latency histogram of a slot, creating it on first use
+     * @param id The handle of the slot
+     * @return Reference to the histogram; it lives until the slot is removed
+     */
+    latency_histogram &slot_latency(slot_id id)
+    {
+        {
+            std::shared_lock lock(_lock);
+
+            if (auto found { _slot_latencies.find(id) }; found != std::end(_slot_latencies)) return *found->second;
+        }
+
+        std::unique_lock lock(_lock);
+
+        auto &histogram { _slot_latencies[id] };
+
+        if (!histogram) histogram = std::make_shared<latency_histogram>();
+
+        return *histogram;
+    }
+
+    /**
+     * @brief Removes the latency histogram of a slot that has been disconnected
+     * @param id The handle of the slot
+     */
+    void remove_slot_latency(slot_id id)
+    {
+        std::unique_lock lock(_lock);
+
+        _slot_latencies.erase(id);
+    }
+
+    /**
+     * @brief Gets the latency histograms of the connected slots invoked so far
+     * @return Pairs of slot handles and histograms, ordered by handle
+     */
+    std::vector<std::pair<slot_id, std::shared_ptr<const latency_histogram>>> get_slot_latencies() const
+    {
+        std::vector<std::pair<slot_id, std::shared_ptr<const latency_histogram>>> latencies;
+
+        {
+            std::shared_lock lock(_lock);
+
+            for (auto &&[id, histogram] : _slot_latencies) latencies.emplace_back(id, histogram);
+        }
+
+        std::sort(std::begin(latencies), std::end(latencies), [](auto &&l, auto &&r){ return l.first < r.first; });
+
+        return latencies;
+    }
+
+    /**
+     * @brief Publishes or removes a gauge
+     * @param kind The gauge
+     * @param read Function reading the gauge, or an empty function to remove it
+     */
+    void set_gauge(gauge kind, gauge_type read)
+    {
+        std::unique_lock lock(_gauge_lock);
+
+        _gauges[static_cast<size_t>(kind)] = std::move(read);
+    }
+
+    /**
+     * @brief Reads a gauge
+     * @param kind The gauge
+     * @return The value, or an empty value if the gauge is not published
+     */
+    std::optional<uint64_t> read_gauge(gauge kind) const
+    {
+        std::shared_lock lock(_gauge_lock);
+
+        auto &read { _gauges[static_cast<size_t>(kind)] };
+
+        return read ? std::optional<uint64_t>{ read() } : std::nullopt;
+    }
+
+private:
+    mutable std::shared_mutex _lock {}, _gauge_lock {};
+    std::u8string _name {};
+    std::atomic_uint64_t _emissions { 0 };
+    std::unordered_map<slot_id, std::shared_ptr<latency_histogram>> _slot_latencies {};
+    std::array<gauge_type, gauge_count> _gauges {};
+};
+
+/**
+ * @brief A registry of the metrics of all instrumented signals
+ * 
+ * Instrumented signals add their metrics to the global registry when they are created.
+ * The registry only keeps weak references, so metrics disappear from the reports once
+ * their signal is destroyed.
+ */
+class signal_metrics_registry
+{
+public:
+    /**
+     * @brief Gets the process-wide registry
+     * @return Reference to the registry
+     */
+    static signal_metrics_registry &global()
+    {
+        static signal_metrics_registry registry {};
+
+        return registry;
+    }
+
+    /**
+     * @brief Adds the metrics of a signal
+     * @param metrics The metrics
+     */
+    void add(const std::shared_ptr<signal_metrics> &metrics)
+    {
+        std::scoped_lock lock(_lock);
+
+        std::erase_if(_metrics, std::mem_fn(&std::weak_ptr<signal_metrics>::expired));
+
+        _metrics.emplace_back(metrics);
+    }
+
+    /**
+     * @brief Gets the metrics of all live signals
+     * @return The metrics, in registration order
+     */
+    std::vector<std::shared_ptr<const signal_metrics>> get_metrics() const
+    {
+        std::vector<std::shared_ptr<const signal_metrics>> metrics;
+
+        std::scoped_lock lock(_lock);
+
+        for (auto &&m : _metrics) if (auto alive { m.lock() }) metrics.push_back(std::move(alive));
+
+        return metrics;
+    }
+
+    /**
+     * @brief Reports all metrics as text, one line per signal followed by one line per slot
+     * @return The report; latencies are in nanoseconds
+     */
+    std::string to_text() const
+    {
+        std::string text;
+
+        for (auto &&m : get_metrics())
+        {
+            text += "signal \"" + to_string(m->name()) + "\": emissions=" + std::to_string(m->get_emission_count());
+
+            for_each_gauge(*m, [&text](std::string_view name, uint64_t value){ text += ' '; text += name; text += '=' + std::to_string(value); });
+
+            text += '\n';
+
+            for (auto &&[id, histogram] : m->get_slot_latencies())
+            {
+                text += "  slot " + std::to_string(static_cast<uint64_t>(id)) + ':';
+
+                for_each_statistic(*histogram, [&text](std::string_view name, uint64_t value){ text += ' '; text += name; text += '=' + std::to_string(value); });
+
+                text += '\n';
+            }
+        }
+
+        return text;
+    }
+
+    /**
+     * @brief Reports all metrics as JSON
+     * @return The report; latencies are in nanoseconds
+     */
+    std::string to_json() const
+    {
+        std::string json { "{\"signals\":[" };
+        bool first_signal { true };
+
+        for (auto &&m : get_metrics())
+        {
+            if (!std::exchange(first_signal, false)) json += ',';
+
+            json += "{\"name\":\"" + escape_json(to_string(m->name())) + "\",\"emissions\":" + std::to_string(m->get_emission_count());
+
+            for_each_gauge(*m, [&json](std::string_view name, uint64_t value){ json += ",\""; json += name; json += "\":" + std::to_string(value); });
+
+            json += ",\"slots\":[";
+
+            bool first_slot { true };
+
+            for (auto &&[id, histogram] : m->get_slot_latencies())
+            {
+                if (!std::exchange(first_slot, false)) json += ',';
+
+                json += "{\"id\":" + std::to_string(static_cast<uint64_t>(id));
+
+                for_each_statistic(*histogram, [&json](std::string_view name, uint64_t value){ json += ",\""; json += name; json += "\":" + std::to_string(value); });
+
+                json += '}';
+            }
+
+            json += "]}";
+        }
+
+        return json + "]}";
+    }
+
+private:
+    mutable std::mutex _lock {};
+    std::vector<std::weak_ptr<signal_metrics>> _metrics {};
+
+    static std::string to_string(std::u8string_view text)
+    {
+        return { reinterpret_cast<const char*>(std::data(text)), std::size(text) };
+    }
+
+    static std::string escape_json(std::string_view text)
+    {
+        std::string escaped;
+
+        for (auto c : text)
+        {
+            if (c == '"' || c == '\\') escaped += { '\\', c };
+            else if (static_cast<unsigned char>(c) < 0x20)
+            {
+                constexpr std::string_view hex { "0123456789abcdef" };
+
+                escaped += "\\u00";
+                escaped += hex[(c >> 4) & 0xf];
+                escaped += hex[c & 0xf];
+            }
+            else escaped += c;
+        }
+
+        return escaped;
+    }
+
+    template<typename Functor>
+    static void for_each_gauge(const signal_metrics &m, Functor &&f)
+    {
+        constexpr std::array<std::string_view, signal_metrics::gauge_count> names { "queue_depth", "dropped", "coalesced" };
+
+        for (size_t kind = 0; kind < std::size(names); ++kind)
+            if (auto value { m.read_gauge(static_cast<signal_metrics::gauge>(kind)) }) f(names[kind], *value);
+    }
+
+    template<typename Functor>
+    static void for_each_statistic(const latency_histogram &h, Functor &&f)
+    {
+        f("count", h.count());
+        f("min_ns", h.min());
+        f("mean_ns", h.mean());
+        f("p50_ns", h.percentile(50));
+        f("p90_ns", h.percentile(90));
+        f("p99_ns", h.percentile(99));
+        f("p999_ns", h.percentile(99.9));
+        f("max_ns", h.max());
+    }
+};
+
+/**
+ * @brief Instrumentation policy of signals that are not instrumented
+ * 
+ * It has no state and its hooks compile to nothing.
+ */
+struct no_instrumentation
+{
+    static constexpr bool enabled { false };
+};
+
+/**
+ * @brief Instrumentation policy counting emissions and timing slots into signal_metrics
+ * 
+ * The metrics are added to the global registry. The hooks are called by the signal
+ * with its emit lock held.
+ */
+class metrics_instrumentation
+{
+public:
+    static constexpr bool enabled { true };
+
+    metrics_instrumentation() : _metrics { std::make_shared<signal_metrics>() }
+    {
+        signal_metrics_registry::global().add(_metrics);
+    }
+
+    metrics_instrumentation(metrics_instrumentation &&other) noexcept = default;
+    metrics_instrumentation &operator=(metrics_instrumentation &&other) noexcept = default;
+
+    /**
+     * @brief Gets the metrics
+     * @return Pointer to the metrics, nullptr if moved from
+     */
+    signal_metrics *metrics() const noexcept { return _metrics.get(); }
+
+    /**
+     * @brief Counts emissions
+     * @param count Number of emissions
+     */
+    void count_emissions(uint64_t count) noexcept
+    {
+        if (_metrics) _metrics->count_emissions(count);
+    }
+
+    /**
+     * @brief Gets the latency histogram of a slot
+     * @param id The handle of the slot
+     * @return Pointer to the histogram, nullptr if moved from
+     */
+    latency_histogram *slot_latency(slot_id id)
+    {
+        if (!_metrics) return nullptr;
+
+        auto &histogram { _slot_latencies[id] };
+
+        if (!histogram) histogram = &_metrics->slot_latency(id);
+
+        return histogram;
+    }
+
+    /**
+     * @brief Drops the latency histogram of a slot that has been removed from the signal
+     * @param id The handle of the slot
+     */
+    void remove_slot(slot_id id)
+    {
+        if (_slot_latencies.erase(id) > 0 && _metrics) _metrics->remove_slot_latency(id);
+    }
+
+private:
+    std::shared_ptr<signal_metrics> _metrics;
+    std::unordered_map<slot_id, latency_histogram*> _slot_latencies {};
+};
+
+/**
+ * @brief Base interface class for all signals
+ * 
+ * Provides a common interface for all signal types.
+ */
+class signal_base
+{
+public:
+    /**
+     * @brief Virtual destructor for proper inheritance
+     */
+    virtual ~signal_base() = default;
+    
+    /**
+     * @brief Gets the name of the signal
+     * @return The signal's name
+     */
+    [[nodiscard]] virtual std::u8string_view name() const = 0;
+    
+    /**
+     * @brief Sets whether the signal is enabled
+     * @param enabled true to enable the signal, false to disable it
+     */
+    virtual void set_enabled(bool enabled) = 0;
+    
+    /**
+     * @brief Checks if the signal is enabled
+     * @return true if the signal is enabled, false otherwise
+     */
+    virtual bool is_enabled() const = 0;
+    
+    /**
+     * @brief Gets the number of slots connected to the signal
+     * @return Number of connected slots
+     */
+    [[nodiscard]] virtual size_t size() const = 0;
+    
+    /**
+     * @brief Gets the signal's payload
+     * @return Reference to the signal's payload
+     */
+    [[nodiscard]] virtual std::any &payload() = 0;
+
+    /**
+     * @brief Gets the metrics of the signal
+     * @return Pointer to the metrics, nullptr if the signal is not instrumented
+     */
+    [[nodiscard]] virtual signal_metrics *metrics() { return nullptr; }
+    
+    /**
+     * @brief Enables or disables a slot
+     * @param slot The slot to enable/disable
+     * @param enabled true to enable the slot, false to disable it
+     */
+    virtual void enable_slot(const slot_base& slot, bool enabled) = 0;
+    
+    /**
+     * @brief Enables or disables a slot by its connection
+     * @param connection The connection to the slot
+     * @param enabled true to enable the slot, false to disable it
+     */
+    virtual void enable_slot(const paired_ptr<>& connection, bool enabled) = 0;
+    
+    /**
+     * @brief Checks if a slot is enabled
+     * @param slot The slot to check
+     * @return true if the slot is enabled, false otherwise
+     */
+    virtual bool is_slot_enabled(const slot_base& slot) const = 0;
+    
+    /**
+     * @brief Checks if a slot is enabled by its connection
+     * @param connection The connection to the slot
+     * @return true if the slot is enabled, false otherwise
+     */
+    virtual bool is_slot_enabled(const paired_ptr<>& connection) const = 0;
+    
+    /**
+     * @brief Gets the priority of a connection
+     * @param connection The connection to check
+     * @return The priority of the connection
+     */
+    virtual int64_t get_connection_priority(const paired_ptr<>& connection) const = 0;
+    
+    /**
+     * @brief Sets the priority of a connection
+     * @param connection The connection to modify
+     * @param priority The new priority
+     * @return true if the priority was set successfully, false otherwise
+     */
+    virtual bool set_connection_priority(const paired_ptr<>& connection, int64_t priority) = 0;
+
+    /**
+     * @brief Enables or disables a slot by its handle
+     * @param id The handle of the slot
+     * @param enabled true to enable the slot, false to disable it
+     */
+    virtual void enable_slot(slot_id id, bool enabled) = 0;
+
+    /**
+     * @brief Checks if a slot is enabled by its handle
+     * @param id The handle of the slot
+     * @return true if the slot is enabled, false otherwise
+     */
+    virtual bool is_slot_enabled(slot_id id) const = 0;
+
+    /**
+     * @brief Gets the priority of a slot by its handle
+     * @param id The handle of the slot
+     * @return The priority of the slot
+     */
+    virtual int64_t get_connection_priority(slot_id id) const = 0;
+
+    /**
+     * @brief Sets the priority of a slot by its handle
+     * @param id The handle of the slot
+     * @param priority The new priority
+     * @return true if the priority was set successfully, false otherwise
+     */
+    virtual bool set_connection_priority(slot_id id, int64_t priority) = 0;
+};
+
+/**
+ * @brief Class representing a connection between a signal and a slot
+ * 
+ * This class manages the lifetime of a connection between a signal and a slot.
+ * When a connection object is destroyed, the connection is automatically broken.
+ */
+class connection
+{
+public:
+    /**
+     * @brief Default constructor creates an empty connection
+     */
+    connection() = default;
+
+    /**
+     * @brief Constructor that connects a signal and a slot
+     * @param signal The signal to connect to
+     * @param s The slot to connect
+     */
+    template<typename... Args>
+    connection(const signal_base *signal, slot<Args...> &s) : _connection{ &s._connection }, _signal { signal }, _slot_id { s._id }
+    {
+    }
+
+    /**
+     * @brief Move constructor
+     * @param other The connection to move from
+     */
+    connection(connection &&other) noexcept = default;
+    
+    connection(const connection &other) = delete;
+    connection &operator=(const connection &other) = delete;
+    
+    /**
+     * @brief Move assignment operator
+     * @param other The connection to move from
+     * @return Reference to this connection
+     */
+    connection &operator=(connection &&other) noexcept
+    {
+        disconnect();
+
+        _connection = std::move(other._connection);
+        _signal = std::move(other._signal);
+        _slot_id = other._slot_id;
+
+        return *this;
+    }
+
+    /**
+     * @brief Destructor that ensures the connection is properly disconnected
+     */
+    ~connection()
+    {
+        disconnect();
+    }
+
+    /**
+     * @brief Disconnects the signal from the slot
+     */
+    void disconnect() noexcept
+    {
+        if (_connection) _connection.disconnect();
+
+        _signal = nullptr;
+    }
+
+    /**
+     * @brief Checks if the connection is disconnected
+     * @return true if the connection is disconnected, false otherwise
+     */
+    [[nodiscard]] bool is_disconnected() const noexcept { return !_connection; }
+
+    /**
+     * @brief Gets the signal this connection is connected to
+     * @return Reference to the connected signal
+     */
+    [[nodiscard]] const signal_base &signal() const noexcept
+    {
+        return *_signal;
+    }
+
+    /**
+     * @brief Gets the handle of the connected slot
+     * @return The slot's handle
+     */
+    [[nodiscard]] slot_id id() const noexcept
+    {
+        return _slot_id;
+    }
+
+    /**
+     * @brief Enables or disables this connection
+     * @param enabled true to enable the connection, false to disable it
+     */
+    void set_enabled(bool enabled)
+    {
+        const_cast<signal_base*>(_signal)->enable_slot(_slot_id, enabled);
+    }
+
+    /**
+     * @brief Checks if this connection is enabled
+     * @return true if the connection is enabled, false otherwise
+     */
+    [[nodiscard]] bool is_enabled() const
+    {
+        return _signal->is_slot_enabled(_slot_id);
+    }
+
+    /**
+     * @brief Gets the priority of this connection
+     * @return The connection's priority
+     */
+    [[nodiscard]] int64_t get_connection_priority() const
+    {
+        return _signal->get_connection_priority(_slot_id);
+    }
+
+    /**
+     * @brief Sets the priority of this connection
+     * @param priority The new priority
+     * @return true if the priority was set successfully, false otherwise
+     */
+    bool set_connection_priority(int64_t priority)
+    {
+        return const_cast<signal_base*>(_signal)->set_connection_priority(_slot_id, priority);
+    }
+
+protected:
+    paired_ptr<> _connection {};
+    const signal_base *_signal { nullptr };
+    slot_id _slot_id { slot_id::invalid };
+};
+
+/**
+ * @brief Base class of the awaiters suspending a coroutine until a signal emission
+ * 
+ * An awaiter lives in the frame of the awaiting coroutine and is linked into an
+ * intrusive list of its source while suspended, so waiting does not allocate. It
+ * resumes with the arguments of the emission, or with an empty value if the source
+ * is destroyed or closed.
+ * 
+ * @tparam Args Types of arguments of the emission
+ */
+template<typename... Args>
+class emission_awaiter
+{
+public:
+    using value_type = std::optional<std::tuple<Args...>>;
+
+    emission_awaiter() = default;
+    emission_awaiter(const emission_awaiter &other) = delete;
+    emission_awaiter &operator=(const emission_awaiter &other) = delete;
+
+    /**
+     * @brief Gets the result of the awaiting
+     * @return The arguments of the emission, or an empty value if the source has ended
+     */
+    value_type await_resume()
+    {
+        return std::move(_value);
+    }
+
+protected:
+    template<typename... T> friend class awaiter_list;
+
+    std::coroutine_handle<> _handle {};
+    value_type _value {};
+    emission_awaiter *_next { nullptr }, *_prev { nullptr };
+    bool _linked { false };
+};
+
+/**
+ * @brief Intrusive FIFO list of suspended emission awaiters
+ * 
+ * The list is not synchronized; its owner guards it.
+ * 
+ * @tparam Args Types of arguments of the emission
+ */
+template<typename... Args>
+class awaiter_list
+{
+public:
+    using awaiter_type = emission_awaiter<Args...>;
+
+    /**
+     * @brief Appends a suspended awaiter
+     */
+    void push_back(awaiter_type &awaiter, std::coroutine_handle<> handle) noexcept
+    {
+        awaiter._handle = handle;
+        awaiter._next = nullptr;
+        awaiter._prev = _tail;
+        awaiter._linked = true;
+
+        if (_tail) _tail->_next = &awaiter;
+        else _head = &awaiter;
+
+        _tail = &awaiter;
+    }
+
+    /**
+     * @brief Unlinks an awaiter that has not been resumed
+     */
+    void remove(awaiter_type &awaiter) noexcept
+    {
+        if (!awaiter._linked) return;
+
+        (awaiter._prev ? awaiter._prev->_next : _head) = awaiter._next;
+        (awaiter._next ? awaiter._next->_prev : _tail) = awaiter._prev;
+
+        awaiter._linked = false;
+    }
+
+    /**
+     * @brief Unlinks the oldest awaiter
+     * @return The awaiter, or nullptr if the list is empty
+     */
+    awaiter_type *pop_front() noexcept
+    {
+        auto awaiter { _head };
+
+        if (awaiter) remove(*awaiter);
+
+        return awaiter;
+    }
+
+    /**
+     * @brief Unlinks all awaiters
+     * @return The first of the awaiters, still chained to each other, or nullptr if the list is empty
+     */
+    awaiter_type *take_all() noexcept
+    {
+        for (auto awaiter { _head }; awaiter; awaiter = awaiter->_next) awaiter->_linked = false;
+
+        _tail = nullptr;
+
+        return std::exchange(_head, nullptr);
+    }
+
+    bool empty() const noexcept { return _head == nullptr; }
+
+    /**
+     * @brief Resumes a chain of awaiters returned by take_all
+     * 
+     * Must be called without holding the owner's lock, as the coroutines run inline.
+     * 
+     * @param awaiter The first awaiter of the chain
+     * @param args Arguments of the emission, copied into each awaiter
+     */
+    static void resume_all(awaiter_type *awaiter, const Args &... args)
+    {
+        while (awaiter) resume(*std::exchange(awaiter, awaiter->_next), args...);
+    }
+
+    /**
+     * @brief Resumes an unlinked awaiter with the arguments of an emission
+     * @param awaiter The awaiter
+     * @param args Arguments of the emission
+     */
+    static void resume(awaiter_type &awaiter, const Args &... args)
+    {
+        awaiter._value.emplace(args...);
+        awaiter._handle.resume();
+    }
+
+    /**
+     * @brief Resumes a chain of awaiters returned by take_all with an empty value
+     * @param awaiter The first awaiter of the chain
+     */
+    static void end_all(awaiter_type *awaiter)
+    {
+        while (awaiter) std::exchange(awaiter, awaiter->_next)->_handle.resume();
+    }
+
+private:
+    awaiter_type *_head { nullptr }, *_tail { nullptr };
+};
+
+/**
+ * @brief The core signal class that can be connected to slots
+ * 
+ * A signal can have multiple slots connected to it. When the signal is emitted,
+ * all connected slots are invoked in order of their priority.
+ * 
+ * @tparam Policy Instrumentation policy, no_instrumentation or metrics_instrumentation
+ * @tparam Args Types of arguments the signal passes to slots when emitted
+ */
+template<typename Policy, typename... Args>
+class basic_signal : public signal_base
+{
+public:
+    using slot_type = slot<Args...>;
+    using slot_container = std::vector<slot_type*>;
+    using instrumentation_policy = Policy;
+
+    /**
+     * @brief Default constructor
+     */
+    basic_signal() = default;
+    
+    /**
+     * @brief Constructor with a name
+     * @param name The name of the signal
+     */
+    basic_signal(const std::u8string &name) : _name{ name }
+    {
+        if constexpr (Policy::enabled) if (auto metrics { _instrumentation.metrics() }) metrics->set_name(name);
+    }
+    
+    /**
+     * @brief Move constructor
+     * @param other The signal to move from
+     */
+    basic_signal(basic_signal &&other) noexcept = default;
+    
+    /**
+     * @brief Move assignment operator
+     * @param other The signal to move from
+     * @return Reference to this signal
+     */
+    basic_signal &operator=(basic_signal &&other) noexcept = default;
+    
+    /**
+     * @brief Awaiter of the next emission of a signal
+     */
+    class next_awaiter : public emission_awaiter<Args...>
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param s The signal to await
+         */
+        explicit next_awaiter(basic_signal &s) noexcept : _signal{ &s } {}
+
+        /**
+         * @brief Destructor that stops awaiting if the coroutine is destroyed while suspended
+         */
+        ~next_awaiter()
+        {
+            if (!this->_linked) return;
+
+            std::scoped_lock lock(_signal->_await_lock);
+
+            _signal->_awaiters.remove(*this);
+            _signal->_has_awaiters = !std::empty(_signal->_awaiters);
+        }
+
+        bool await_ready() const noexcept { return false; }
+
+        /**
+         * @brief Suspends the coroutine until the next emission
+         * @param handle The awaiting coroutine
+         */
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            std::scoped_lock lock(_signal->_await_lock);
+
+            _signal->_awaiters.push_back(*this, handle);
+            _signal->_has_awaiters = true;
+        }
+
+    private:
+        basic_signal *_signal;
+    };
+
+    /**
+     * @brief Virtual destructor that ends the coroutines awaiting the next emission
+     */
+    virtual ~basic_signal() override
+    {
+        awaiter_list<Args...>::end_all(take_awaiters());
+    }
+
+    /**
+     * @brief Emits the signal with the given arguments
+     * 
+     * When a signal is emitted, all connected slots are invoked with the
+     * provided arguments. Slots are invoked in order of their priority.
+     * Coroutines awaiting the next emission are resumed afterwards, once the
+     * signal is unlocked.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit(const Args &... args)
+    {
+        if (!_enabled) return;
+
+        {
+            std::scoped_lock lock_emit(_emit_lock);
+
+            if (!_enabled) return;
+
+            if constexpr (Policy::enabled) _instrumentation.count_emissions(1);
+
+            dispatch([&args...](const slot_type &callable){ callable.invoke(args...); });
+        }
+
+        if (_has_awaiters.load(std::memory_order_relaxed)) resume_awaiters(args...);
+    }
+
+    /**
+     * @brief Emits the signal with arguments that may be moved from
+     * 
+     * The last slot invoked gets the arguments by rvalue if it consumes them, so a
+     * payload is passed through without a copy when only one slot takes ownership;
+     * move-only arguments such as std::unique_ptr are supported. The slots before it
+     * are invoked as by the const overload. If coroutines are awaiting the emission,
+     * nothing is moved and they are resumed afterwards.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit(Args &&... args) requires (sizeof...(Args) > 0 && (!std::is_reference_v<Args> && ...))
+    {
+        if (!_enabled) return;
+
+        const bool has_awaiters { _has_awaiters.load(std::memory_order_relaxed) };
+
+        {
+            std::scoped_lock lock_emit(_emit_lock);
+
+            if (!_enabled) return;
+
+            if constexpr (Policy::enabled) _instrumentation.count_emissions(1);
+
+            dispatch([&args..., has_awaiters](const slot_type &callable, bool last)
+            {
+                if (last && !has_awaiters) callable.consume(args...);
+                else callable.invoke(args...);
+            });
+        }
+
+        if (has_awaiters) resume_awaiters(args...);
+    }
+
+    /**
+     * @brief Awaits the next emission of the signal
+     * 
+     * The awaiting coroutine is resumed on the emitting thread with the arguments of the
+     * emission, or with an empty value if the signal is destroyed first. Waiting does not
+     * allocate.
+     * 
+     * @return The awaiter to co_await
+     */
+    [[nodiscard]] next_awaiter next() noexcept requires std::copy_constructible<std::tuple<Args...>>
+    {
+        return next_awaiter{ *this };
+    }
+
+    /**
+     * @brief Emits the signal once for every argument tuple of a batch
+     * 
+     * The locks are taken and the pending connections are merged only once per batch.
+     * Each slot is invoked over the whole batch before the next slot is invoked, so the
+     * order of invocations differs from emitting the items one by one: slots are still
+     * invoked in order of their priority, and every slot sees the items in batch order.
+     * Batch-aware slots receive the whole span in a single call. Coroutines awaiting the
+     * next emission are resumed with the first item of the batch.
+     * 
+     * @param batch The argument tuples of the emissions
+     */
+    void emit_batch(std::span<const std::tuple<Args...>> batch)
+    {
+        if (!_enabled || std::empty(batch)) return;
+
+        {
+            std::scoped_lock lock_emit(_emit_lock);
+
+            if (!_enabled) return;
+
+            if constexpr (Policy::enabled) _instrumentation.count_emissions(std::size(batch));
+
+            dispatch([batch](const slot_type &callable){ callable.invoke_batch(batch); });
+        }
+
+        if (_has_awaiters.load(std::memory_order_relaxed))
+            std::apply([this](const Args &... a){ resume_awaiters(a...); }, batch.front());
+    }
+
+    /**
+     * @brief Emits the signal asynchronously
+     * 
+     * Slots are invoked in order of their priority, each according to its affinity:
+     * slots connected without one run on the calling thread before emit_async returns,
+     * the others are handed over to the signal's executor or their strand. The arguments
+     * are copied once and shared by the asynchronous slots. Slots disconnected after
+     * this call may still be invoked by it; wait on the returned handle before
+     * destroying what they use.
+     * 
+     * @param args Arguments to pass to the slots
+     * @return Handle to wait for the completion of all slots
+     */
+    async_emission emit_async(const Args &... args) requires std::copy_constructible<std::tuple<Args...>>
+    {
+        async_emission completion {};
+
+        if (!_enabled) return completion;
+
+        {
+            std::scoped_lock lock_emit(_emit_lock);
+
+            if (!_enabled) return completion;
+
+            if constexpr (Policy::enabled) _instrumentation.count_emissions(1);
+
+            std::shared_ptr<const std::tuple<Args...>> shared_args {};
+
+            dispatch([&](const slot_type &callable)
+            {
+                if (callable.get_affinity() == slot_affinity::caller)
+                {
+                    completion.run([&]{ callable.invoke(args...); });
+
+                    return;
+                }
+
+                if (!shared_args) shared_args = std::make_shared<const std::tuple<Args...>>(args...);
+
+                callable.invoke_async(completion, _executor, shared_args);
+            });
+        }
+
+        if (_has_awaiters.load(std::memory_order_relaxed)) resume_awaiters(args...);
+
+        return completion;
+    }
+
+    /**
+     * @brief Sets the executor running the slots with executor affinity on emit_async
+     * @param executor The executor; such slots run on the emitting thread if it is empty
+     */
+    void set_executor(executor_type executor)
+    {
+        std::scoped_lock lock_emit(_emit_lock);
+
+        _executor = std::move(executor);
+    }
+
+    /**
+     * @brief Function call operator to emit the signal
+     * @param args Arguments to pass to the slots
+     */
+    void operator() (const Args &... args)
+    {
+        emit(args...);
+    }
+
+    /**
+     * @brief Function call operator to emit the signal with arguments that may be moved from
+     * @param args Arguments to pass to the slots
+     */
+    void operator() (Args &&... args) requires (sizeof...(Args) > 0 && (!std::is_reference_v<Args> && ...))
+    {
+        emit(std::move(args)...);
+    }
+
+    /**
+     * @brief Connects a function to this signal
+     * 
+     * A function taking the arguments by rvalue consumes them, see slot.
+     * 
+     * @param callable Function to connect
+     * @param priority Priority of the connection
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename Callable>
+    requires std::constructible_from<slot_type, Callable, int64_t>
+    [[nodiscard]] connection connect(Callable &&callable, int64_t priority = 0)
+    {
+        return connect_slot(std::forward<Callable>(callable), priority);
+    }
+
+    /**
+     * @brief Connects a std::function to this signal
+     * 
+     * Other callables are taken by the template overload without being converted to a
+     * std::function, so overriding this function only intercepts std::function objects.
+     * 
+     * @param callable Function to connect
+     * @param priority Priority of the connection
+     * @return A connection object that manages the connection's lifetime
+     */
+    [[nodiscard]] virtual connection connect(std::function<void(Args...)> &&callable, int64_t priority = 0)
+    {
+        return connect_slot(std::move(callable), priority);
+    }
+
+    /**
+     * @brief Connects a batch-aware function to this signal
+     * 
+     * The function receives all emissions of an emit_batch call as one span.
+     * 
+     * @param callable Function accepting a span of argument tuples
+     * @param priority Priority of the connection
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename Callable>
+    requires std::invocable<std::decay_t<Callable>&, typename slot_type::batch_type>
+    [[nodiscard]] connection connect_batch(Callable &&callable, int64_t priority = 0)
+    {
+        return connect_slot(batch_slot, std::forward<Callable>(callable), priority);
+    }
+
+    /**
+     * @brief Connects a function to this signal with an affinity for emit_async
+     * 
+     * @param callable Function to connect
+     * @param affinity Where the function runs on emit_async; slot_affinity::strand requires the strand overload
+     * @param priority Priority of the connection
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename Callable>
+    requires std::invocable<std::decay_t<Callable>&, const Args &...>
+    [[nodiscard]] connection connect(Callable &&callable, slot_affinity affinity, int64_t priority = 0)
+    {
+        return connect_slot(std::forward<Callable>(callable), affinity, nullptr, priority);
+    }
+
+    /**
+     * @brief Connects a function to this signal that runs on a strand on emit_async
+     * 
+     * @param callable Function to connect
+     * @param s The strand; it must outlive the connection and the emissions
+     * @param priority Priority of the connection
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename Callable>
+    requires std::invocable<std::decay_t<Callable>&, const Args &...>
+    [[nodiscard]] connection connect(Callable &&callable, strand &s, int64_t priority = 0)
+    {
+        return connect_slot(std::forward<Callable>(callable), slot_affinity::strand, &s, priority);
+    }
+
+    /**
+     * @brief Operator += to connect a function to this signal
+     * @param callable Function to connect
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename Callable>
+    requires std::constructible_from<slot_type, Callable, int64_t>
+    [[nodiscard]] connection operator += (Callable &&callable)
+    {
+        return connect(std::forward<Callable>(callable));
+    }
+
+    /**
+     * @brief Operator += to connect a std::function to this signal
+     * @param callable Function to connect
+     * @return A connection object that manages the connection's lifetime
+     */
+    [[nodiscard]] virtual connection operator += (std::function<void(Args...)> &&callable)
+    {
+        return connect(std::move(callable));
+    }
+
+    /**
+     * @brief Connects a member function to this signal
+     * 
+     * @param instance The object instance
+     * @param member_function Member function to connect
+     * @param priority Priority of the connection (lower value means higher priority)
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename T>
+    [[nodiscard]] connection connect(T *instance, void (T::*member_function)(Args...), int64_t priority = 0)
+    {
+        return connect([instance, member_function](Args... args) { (instance->*member_function)(std::forward<Args>(args)...); }, priority);
+    }
+
+    /**
+     * @brief Disconnects all slots from this signal
+     */
+    virtual void clear()
+    {
+        std::scoped_lock lock(_connect_lock, _emit_lock, _index_lock);
+
+        for (auto s : _pending_connections) _slot_pool.destroy(s);
+
+        for (auto s : _slots)
+        {
+            if constexpr (Policy::enabled) _instrumentation.remove_slot(s->_id);
+
+            _slot_pool.destroy(s);
+        }
+
+        _pending_connections.clear();
+        _slots.clear();
+        _slot_index.clear();
+    }
+
+    /**
+     * @brief Gets the number of slots connected to this signal
+     * @return Number of connected slots
+     */
+    virtual size_t size() const override
+    {
+        std::scoped_lock lock(_emit_lock);
+
+        return std::size(_slots);
+    }
+
+    /**
+     * @brief Sets the name of this signal
+     * @param name The new name
+     */
+    void name(const std::u8string &name)
+    {
+        std::unique_lock<std::shared_mutex> lock { _name_lock };
+
+        _name = name;
+
+        if constexpr (Policy::enabled) if (auto metrics { _instrumentation.metrics() }) metrics->set_name(name);
+    }
+
+    /**
+     * @brief Gets the name of this signal
+     * @return The signal's name
+     */
+    virtual std::u8string_view name() const override
+    {
+        std::shared_lock<std::shared_mutex> lock { _name_lock };
+
+        return _name;
+    }
+
+    /**
+     * @brief Sets whether this signal is enabled
+     * @param enabled true to enable the signal, false to disable it
+     */
+    virtual void set_enabled(bool enabled) override
+    {
+        _enabled = enabled;
+    }
+
+    /**
+     * @brief Checks if this signal is enabled
+     * @return true if the signal is enabled, false otherwise
+     */
+    virtual bool is_enabled() const override
+    {
+        return _enabled;
+    }
+
+    /**
+     * @brief Gets this signal's payload
+     * @return Reference to the signal's payload
+     */
+    virtual std::any &payload() override
+    {
+        return _payload;
+    }
+
+    /**
+     * @brief Enables or disables a slot
+     * @param slot The slot to enable/disable
+     * @param enabled true to enable the slot, false to disable it
+     */
+    virtual void enable_slot(const slot_base &slot, bool enabled) override
+    {
+        enable_slot(slot._id, enabled);
+    }
+
+    /**
+     * @brief Enables or disables a slot by its connection
+     * @param s The connection to the slot
+     * @param enabled true to enable the slot, false to disable it
+     */
+    virtual void enable_slot(const paired_ptr<> &s, bool enabled) override
+    {
+        std::shared_lock<std::shared_mutex> lock { _index_lock };
+
+        if (auto s_ptr = find_slot(s); s_ptr != nullptr) s_ptr->set_enabled(enabled);
+    }
+
+    /**
+     * @brief Enables or disables a slot by its handle
+     * @param id The handle of the slot
+     * @param enabled true to enable the slot, false to disable it
+     */
+    virtual void enable_slot(slot_id id, bool enabled) override
+    {
+        std::shared_lock<std::shared_mutex> lock { _index_lock };
+
+        if (auto s_ptr = find_slot(id); s_ptr != nullptr) s_ptr->set_enabled(enabled);
+    }
+
+    /**
+     * @brief Checks if a slot is enabled
+     * @param slot The slot to check
+     * @return true if the slot is enabled, false otherwise
+     */
+    virtual bool is_slot_enabled(const slot_base &slot) const override
+    {
+        return is_slot_enabled(slot._id);
+    }
+
+    /**
+     * @brief Checks if a slot is enabled by its connection
+     * @param slot The connection to the slot
+     * @return true if the slot is enabled, false otherwise
+     */
+    virtual bool is_slot_enabled(const paired_ptr<> &slot) const override
+    {
+        std::shared_lock<std::shared_mutex> lock { _index_lock };
+
+        if (auto s_ptr = find_slot(slot); s_ptr != nullptr) return s_ptr->is_enabled();
+
+        return false;
+    }
+
+    /**
+     * @brief Checks if a slot is enabled by its handle
+     * @param id The handle of the slot
+     * @return true if the slot is enabled, false otherwise
+     */
+    virtual bool is_slot_enabled(slot_id id) const override
+    {
+        std::shared_lock<std::shared_mutex> lock { _index_lock };
+
+        if (auto s_ptr = find_slot(id); s_ptr != nullptr) return s_ptr->is_enabled();
+
+        return false;
+    }
+
+    /**
+     * @brief Gets the priority of a connection
+     * @param con The connection to check
+     * @return The priority of the connection
+     */
+    virtual int64_t get_connection_priority(const paired_ptr<>& con) const override
+    {
+        std::shared_lock<std::shared_mutex> lock { _index_lock };
+
+        if (auto s_ptr = find_slot(con); s_ptr != nullptr) return s_ptr->get_priority();
+
+        return {};
+    }
+
+    /**
+     * @brief Gets the priority of a slot by its handle
+     * @param id The handle of the slot
+     * @return The priority of the slot
+     */
+    virtual int64_t get_connection_priority(slot_id id) const override
+    {
+        std::shared_lock<std::shared_mutex> lock { _index_lock };
+
+        if (auto s_ptr = find_slot(id); s_ptr != nullptr) return s_ptr->get_priority();
+
+        return {};
+    }
+
+    /**
+     * @brief Sets the priority of a connection
+     * 
+     * The slot is repositioned lazily, before the next emission.
+     * 
+     * @param con The connection to modify
+     * @param priority The new priority
+     * @return true if the priority was set successfully, false otherwise
+     */
+    virtual bool set_connection_priority(const paired_ptr<>& con, int64_t priority) override
+    {
+        std::unique_lock<std::shared_mutex> lock { _index_lock };
+
+        return set_slot_priority(find_slot(con), priority);
+    }
+
+    /**
+     * @brief Sets the priority of a slot by its handle
+     * 
+     * The slot is repositioned lazily, before the next emission.
+     * 
+     * @param id The handle of the slot
+     * @param priority The new priority
+     * @return true if the priority was set successfully, false otherwise
+     */
+    virtual bool set_connection_priority(slot_id id, int64_t priority) override
+    {
+        std::unique_lock<std::shared_mutex> lock { _index_lock };
+
+        return set_slot_priority(find_slot(id), priority);
+    }
+
+    /**
+     * @brief Gets the metrics of this signal
+     * @return Pointer to the metrics, nullptr if the signal is not instrumented
+     */
+    virtual signal_metrics *metrics() override
+    {
+        if constexpr (Policy::enabled) return _instrumentation.metrics();
+        else return nullptr;
+    }
+
+protected:
+    std::u8string _name {};
+    stable_pool<slot_type> _slot_pool {};
+    slot_container _pending_connections {};
+    slot_container _slots {};
+    slot_index<slot_type*> _slot_index {};
+    mutable std::mutex _connect_lock {}, _emit_lock {};
+    mutable std::shared_mutex _name_lock {}, _index_lock {};
+    mutable std::atomic_bool _enabled { true };
+    std::atomic_bool _resort_pending { false };
+    executor_type _executor {};
+    std::any _payload;
+    awaiter_list<Args...> _awaiters {};
+    std::mutex _await_lock {};
+    std::atomic_bool _has_awaiters { false };
+    [[no_unique_address]] Policy _instrumentation {};
+
+    /**
+     * @brief Unlinks all coroutines awaiting the next emission
+     * @return The first of the awaiters
+     */
+    emission_awaiter<Args...> *take_awaiters()
+    {
+        std::scoped_lock lock(_await_lock);
+
+        _has_awaiters = false;
+
+        return _awaiters.take_all();
+    }
+
+    /**
+     * @brief Resumes all coroutines awaiting the next emission with its arguments
+     * 
+     * Awaiting requires copyable arguments, so there is nothing to resume otherwise.
+     * 
+     * @param args Arguments of the emission
+     */
+    void resume_awaiters(const Args &... args)
+    {
+        if constexpr (std::is_copy_constructible_v<std::tuple<Args...>>) awaiter_list<Args...>::resume_all(take_awaiters(), args...);
+    }
+
+    /**
+     * @brief Invokes all enabled slots in order of their priority
+     * 
+     * The caller must hold the emit lock. Pending connections are merged first, and
+     * slots found disconnected are removed afterwards. An invoker taking a second, bool
+     * argument is told whether the slot is the last one to be invoked. Instrumented
+     * signals record how long every invoker call takes.
+     * 
+     * @param invoker Function invoking a single slot
+     */
+    template<typename Invoker>
+    void dispatch(Invoker &&invoker)
+    {
+        merge_pending_connections();
+
+        bool has_disconnected { false };
+        [[maybe_unused]] const slot_type *last { nullptr };
+
+        if constexpr (std::invocable<Invoker&, const slot_type&, bool>)
+        {
+            auto found { std::find_if(std::rbegin(_slots), std::rend(_slots), [](const slot_type *s){ return !s->is_disconnected() && s->is_enabled(); }) };
+
+            if (found != std::rend(_slots)) last = *found;
+        }
+
+        for (auto slot_ptr : _slots)
+        {
+            auto &callable { *slot_ptr };
+
+            if (callable.is_disconnected()) { has_disconnected = true; continue; }
+
+            if (callable.is_enabled())
+            {
+                auto invoke_slot { [&]
+                {
+                    if constexpr (std::invocable<Invoker&, const slot_type&, bool>) invoker(callable, &callable == last);
+                    else invoker(callable);
+                } };
+
+                if constexpr (Policy::enabled)
+                {
+                    if (auto latency { _instrumentation.slot_latency(callable._id) })
+                    {
+                        auto start { std::chrono::steady_clock::now() };
+
+                        invoke_slot();
+
+                        latency->record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+                    }
+                    else invoke_slot();
+                }
+                else invoke_slot();
+            }
+
+            if (callable.is_disconnected()) has_disconnected = true;
+        }
+
+        if (has_disconnected)
+        {
+            std::unique_lock<std::shared_mutex> lock_index { _index_lock };
+
+            erase_disconnected(_slots);
+        }
+    }
+
+    /**
+     * @brief Adds a new slot to the pending connections
+     * @param slot_args Arguments to construct the slot from
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename... SlotArgs>
+    connection connect_slot(SlotArgs &&... slot_args)
+    {
+        std::scoped_lock lock(_connect_lock);
+        std::unique_lock<std::shared_mutex> lock_index { _index_lock };
+
+        erase_disconnected(_pending_connections);
+
+        _pending_connections.reserve(std::size(_pending_connections) + 1);
+
+        auto new_slot { _slot_pool.create(std::forward<SlotArgs>(slot_args)...) };
+
+        new_slot->_id = _slot_index.acquire(new_slot);
+
+        _pending_connections.push_back(new_slot);
+
+        return { this, *new_slot };
+    }
+
+    /**
+     * @brief Moves pending connections into the priority-sorted slot vector
+     * 
+     * Pending slots are merged after the already connected slots of equal priority,
+     * so the connection order is preserved within a priority. Slots whose priority
+     * has been changed since the last emission are repositioned here as well.
+     */
+    void merge_pending_connections()
+    {
+        std::scoped_lock lock_con(_connect_lock);
+
+        auto resort { _resort_pending.exchange(false) };
+
+        if (std::empty(_pending_connections) && !resort) return;
+
+        std::unique_lock<std::shared_mutex> lock_index { _index_lock };
+
+        erase_disconnected(_pending_connections);
+
+        if (resort) std::stable_sort(std::begin(_slots), std::end(_slots), by_priority);
+
+        if (std::size(_pending_connections) == 1)
+        {
+            auto pending { _pending_connections.front() };
+
+            _slots.insert(std::upper_bound(std::begin(_slots), std::end(_slots), pending, by_priority), pending);
+        }
+        else if (!std::empty(_pending_connections))
+        {
+            std::stable_sort(std::begin(_pending_connections), std::end(_pending_connections), by_priority);
+
+            auto middle { static_cast<std::ptrdiff_t>(std::size(_slots)) };
+
+            _slots.insert(std::end(_slots), std::begin(_pending_connections), std::end(_pending_connections));
+            std::inplace_merge(std::begin(_slots), std::begin(_slots) + middle, std::end(_slots), by_priority);
+        }
+
+        _pending_connections.clear();
+    }
+
+    /**
+     * @brief Orders slots by their priority
+     */
+    static bool by_priority(const slot_type *left, const slot_type *right) noexcept
+    {
+        return *left < *right;
+    }
+
+    /**
+     * @brief Removes disconnected slots, invalidates their handles and recycles their storage
+     * 
+     * The caller must hold the index lock exclusively. Slots removed from the connected
+     * ones also lose their latency histograms; the emit lock is held then, and pending
+     * slots have never been timed.
+     * 
+     * @param slots The slot vector to compact
+     * @return Number of removed slots
+     */
+    size_t erase_disconnected(slot_container &slots)
+    {
+        return std::erase_if(slots, [this, connected = &slots == &_slots](slot_type *s)
+        {
+            if (!s->is_disconnected()) return false;
+
+            if constexpr (Policy::enabled) if (connected) _instrumentation.remove_slot(s->_id);
+
+            _slot_index.release(s->_id);
+            _slot_pool.destroy(s);
+
+            return true;
+        });
+    }
+
+    /**
+     * @brief Sets the priority of a slot and schedules its repositioning
+     * 
+     * The caller must hold the index lock exclusively.
+     * 
+     * @param s_ptr The slot to modify
+     * @param priority The new priority
+     * @return true if the priority was set successfully, false otherwise
+     */
+    bool set_slot_priority(slot_type *s_ptr, int64_t priority)
+    {
+        if (s_ptr == nullptr) return false;
+
+        if (s_ptr->set_priority(priority) != priority) _resort_pending = true;
+
+        return true;
+    }
+
+    /**
+     * @brief Finds a slot by its handle
+     * 
+     * The caller must hold the index lock.
+     * 
+     * @param id The handle of the slot
+     * @return Pointer to the slot if found, nullptr otherwise
+     */
+    slot_type* find_slot(slot_id id) const
+    {
+        auto s_ptr { _slot_index.find(id) };
+
+        return s_ptr ? *s_ptr : nullptr;
+    }
+
+    /**
+     * @brief Finds a slot by its connection
+     * 
+     * The caller must hold the index lock.
+     * 
+     * @param con The connection to find
+     * @return Pointer to the slot if found, nullptr otherwise
+     */
+    slot_type* find_slot(const paired_ptr<>& con) const
+    {
+        auto base { slot_base::from_connection(con) };
+
+        if (base == nullptr) return nullptr;
+
+        auto s_ptr { find_slot(base->_id) };
+
+        return (s_ptr != nullptr && *s_ptr == con) ? s_ptr : nullptr;
+    }
+};
+
+/**
+ * @brief The signal class that can be connected to slots, without instrumentation
+ * 
+ * @tparam Args Types of arguments the signal passes to slots when emitted
+ */
+template<typename... Args>
+class signal : public basic_signal<no_instrumentation, Args...>
+{
+public:
+    using basic_signal<no_instrumentation, Args...>::basic_signal;
+};
+
+/**
+ * @brief A signal that records its emissions and the latency of every slot
+ * 
+ * Its metrics are added to signal_metrics_registry::global() and can be
+ * reached through metrics().
+ * 
+ * @tparam Args Types of arguments the signal passes to slots when emitted
+ */
+template<typename... Args>
+class instrumented_signal : public basic_signal<metrics_instrumentation, Args...>
+{
+public:
+    using basic_signal<metrics_instrumentation, Args...>::basic_signal;
+};
+
+/**
+ * @brief Extended signal class that passes itself as the first argument to slots
+ * 
+ * This is useful when slots need to know which signal triggered them.
+ * 
+ * @tparam Args Types of additional arguments the signal passes to slots
+ */
+template<typename... Args>
+class signal_ex : public signal<signal_base*, Args...>
+{
+public:
+    using base_class = signal<signal_base*, Args...>;
+
+    /**
+     * @brief Default constructor
+     */
+    signal_ex() = default;
+    
+    /**
+     * @brief Constructor with a name
+     * @param name The name of the signal
+     */
+    signal_ex(const std::u8string &name) : base_class(name) {}
+    
+    /**
+     * @brief Move constructor
+     * @param other The signal to move from
+     */
+    signal_ex(signal_ex &&other) noexcept = default;
+    
+    /**
+     * @brief Move assignment operator
+     * @param other The signal to move from
+     * @return Reference to this signal
+     */
+    signal_ex &operator=(signal_ex &&other) noexcept = default;
+    
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~signal_ex() override = default;
+
+    /**
+     * @brief Emits the signal with the given arguments
+     * 
+     * Unlike the base signal class, this automatically passes itself as the first argument.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit(const Args&... args)
+    {
+        base_class::emit(this, args...);
+    }
+
+    /**
+     * @brief Emits the signal with arguments that may be moved from, passing itself as the first argument
+     * @param args Arguments to pass to the slots
+     */
+    void emit(Args&&... args) requires (sizeof...(Args) > 0 && (!std::is_reference_v<Args> && ...))
+    {
+        base_class::emit(this, std::move(args)...);
+    }
+
+    /**
+     * @brief Emits the signal asynchronously, passing itself as the first argument
+     * @param args Arguments to pass to the slots
+     * @return Handle to wait for the completion of all slots
+     */
+    async_emission emit_async(const Args&... args)
+    {
+        return base_class::emit_async(this, args...);
+    }
+
+    /**
+     * @brief Function call operator to emit the signal
+     * @param args Arguments to pass to the slots
+     */
+    void operator() (const Args&... args)
+    {
+        emit(args...);
+    }
+
+    /**
+     * @brief Function call operator to emit the signal with arguments that may be moved from
+     * @param args Arguments to pass to the slots
+     */
+    void operator() (Args&&... args) requires (sizeof...(Args) > 0 && (!std::is_reference_v<Args> && ...))
+    {
+        emit(std::move(args)...);
+    }
+};
+
+/**
+ * @brief A signal whose emission path is free of mutexes
+ * 
+ * The connected slots are kept in an immutable, reference-counted snapshot that is
+ * sorted by priority. Emitting only acquires the current snapshot, so any number of
+ * threads may emit the same signal concurrently. Connecting, clearing and changing
+ * priorities publish a new snapshot (copy-on-write); emitters that are in flight keep
+ * using the snapshot they started with. Disconnected slots are pruned lazily by the
+ * next writer, or by an emitter that manages to grab the writer lock without waiting.
+ * 
+ * @tparam Args Types of arguments the signal passes to slots when emitted
+ */
+template<typename... Args>
+class concurrent_signal : public signal_base
+{
+public:
+    using slot_type = slot<Args...>;
+    using slot_ptr = std::shared_ptr<slot_type>;
+    using snapshot_type = std::vector<slot_ptr>;
+    using snapshot_ptr = std::shared_ptr<const snapshot_type>;
+
+    /**
+     * @brief Default constructor
+     */
+    concurrent_signal() = default;
+    
+    /**
+     * @brief Constructor with a name
+     * @param name The name of the signal
+     */
+    concurrent_signal(const std::u8string &name) : _name{ name } {}
+    
+    /**
+     * @brief Move constructor
+     * @param other The signal to move from
+     */
+    concurrent_signal(concurrent_signal &&other) noexcept = default;
+    
+    /**
+     * @brief Move assignment operator
+     * @param other The signal to move from
+     * @return Reference to this signal
+     */
+    concurrent_signal &operator=(concurrent_signal &&other) noexcept = default;
+    
+    /**
+     * @brief Virtual destructor
+     */
+    virtual ~concurrent_signal() override = default;
+
+    /**
+     * @brief Emits the signal with the given arguments
+     * 
+     * All connected slots of the current snapshot are invoked in order of their priority.
+     * Slots connected while the emission is in progress are not invoked by it.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit(const Args &... args)
+    {
+        if (!_enabled) return;
+
+        dispatch([&args...](const slot_type &callable){ callable.invoke(args...); });
+    }
+
+    /**
+     * @brief Emits the signal with arguments that may be moved from
+     * 
+     * The last slot invoked gets the arguments by rvalue if it consumes them, so a
+     * payload is passed through without a copy when only one slot takes ownership;
+     * move-only arguments such as std::unique_ptr are supported. The slots before it
+     * are invoked as by the const overload.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit(Args &&... args) requires (sizeof...(Args) > 0 && (!std::is_reference_v<Args> && ...))
+    {
+        if (!_enabled) return;
+
+        dispatch([&args...](const slot_type &callable, bool last)
+        {
+            if (last) callable.consume(args...);
+            else callable.invoke(args...);
+        });
+    }
+
+    /**
+     * @brief Emits the signal once for every argument tuple of a batch
+     * 
+     * The snapshot is acquired only once per batch. Each slot is invoked over the whole
+     * batch before the next slot is invoked; batch-aware slots receive the whole span
+     * in a single call.
+     * 
+     * @param batch The argument tuples of the emissions
+     */
+    void emit_batch(std::span<const std::tuple<Args...>> batch)
+    {
+        if (!_enabled || std::empty(batch)) return;
+
+        dispatch([batch](const slot_type &callable){ callable.invoke_batch(batch); });
+    }
+
+    /**
+     * @brief Emits the signal asynchronously
+     * 
+     * Slots are invoked in order of their priority, each according to its affinity:
+     * slots connected without one run on the calling thread before emit_async returns,
+     * the others are handed over to the signal's executor or their strand. The arguments
+     * are copied once and shared by the asynchronous slots. Slots disconnected after
+     * this call may still be invoked by it; wait on the returned handle before
+     * destroying what they use.
+     * 
+     * @param args Arguments to pass to the slots
+     * @return Handle to wait for the completion of all slots
+     */
+    async_emission emit_async(const Args &... args) requires std::copy_constructible<std::tuple<Args...>>
+    {
+        async_emission completion {};
+
+        if (!_enabled) return completion;
+
+        auto executor { _executor.load(std::memory_order_acquire) };
+        std::shared_ptr<const std::tuple<Args...>> shared_args {};
+
+        dispatch([&](const slot_type &callable)
+        {
+            if (callable.get_affinity() == slot_affinity::caller)
+            {
+                completion.run([&]{ callable.invoke(args...); });
+
+                return;
+            }
+
+            if (!shared_args) shared_args = std::make_shared<const std::tuple<Args...>>(args...);
+
+            callable.invoke_async(completion, executor ? *executor : _no_executor, shared_args);
+        });
+
+        return completion;
+    }
+
+    /**
+     * @brief Sets the executor running the slots with executor affinity on emit_async
+     * @param executor The executor; such slots run on the emitting thread if it is empty
+     */
+    void set_executor(executor_type executor)
+    {
+        _executor.store(executor ? std::make_shared<const executor_type>(std::move(executor)) : nullptr, std::memory_order_release);
+    }
+
+    /**
+     * @brief Function call operator to emit the signal
+     * @param args Arguments to pass to the slots
+     */
+    void operator() (const Args &... args)
+    {
+        emit(args...);
+    }
+
+    /**
+     * @brief Function call operator to emit the signal with arguments that may be moved from
+     * @param args Arguments to pass to the slots
+     */
+    void operator() (Args &&... args) requires (sizeof...(Args) > 0 && (!std::is_reference_v<Args> && ...))
+    {
+        emit(std::move(args)...);
+    }
+
+    /**
+     * @brief Connects a function to this signal
+     * 
+     * A function taking the arguments by rvalue consumes them, see slot.
+     * 
+     * @param callable Function to connect
+     * @param priority Priority of the connection
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename Callable>
+    requires std::constructible_from<slot_type, Callable, int64_t>
+    [[nodiscard]] connection connect(Callable &&callable, int64_t priority = 0)
+    {
+        return connect_slot(std::make_shared<slot_type>(std::forward<Callable>(callable), priority));
+    }
+
+    /**
+     * @brief Connects a batch-aware function to this signal
+     * 
+     * The function receives all emissions of an emit_batch call as one span.
+     * 
+     * @param callable Function accepting a span of argument tuples
+     * @param priority Priority of the connection
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename Callable>
+    requires std::invocable<std::decay_t<Callable>&, typename slot_type::batch_type>
+    [[nodiscard]] connection connect_batch(Callable &&callable, int64_t priority = 0)
+    {
+        return connect_slot(std::make_shared<slot_type>(batch_slot, std::forward<Callable>(callable), priority));
+    }
+
+    /**
+     * @brief Connects a function to this signal with an affinity for emit_async
+     * 
+     * @param callable Function to connect
+     * @param affinity Where the function runs on emit_async; slot_affinity::strand requires the strand overload
+     * @param priority Priority of the connection
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename Callable>
+    requires std::invocable<std::decay_t<Callable>&, const Args &...>
+    [[nodiscard]] connection connect(Callable &&callable, slot_affinity affinity, int64_t priority = 0)
+    {
+        return connect_slot(std::make_shared<slot_type>(std::forward<Callable>(callable), affinity, nullptr, priority));
+    }
+
+    /**
+     * @brief Connects a function to this signal that runs on a strand on emit_async
+     * 
+     * @param callable Function to connect
+     * @param s The strand; it must outlive the connection and the emissions
+     * @param priority Priority of the connection
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename Callable>
+    requires std::invocable<std::decay_t<Callable>&, const Args &...>
+    [[nodiscard]] connection connect(Callable &&callable, strand &s, int64_t priority = 0)
+    {
+        return connect_slot(std::make_shared<slot_type>(std::forward<Callable>(callable), slot_affinity::strand, &s, priority));
+    }
+
+    /**
+     * @brief Operator += to connect a function to this signal
+     * @param callable Function to connect
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename Callable>
+    requires std::constructible_from<slot_type, Callable, int64_t>
+    [[nodiscard]] connection operator += (Callable &&callable)
+    {
+        return connect(std::forward<Callable>(callable));
+    }
+
+    /**
+     * @brief Connects a member function to this signal
+     * 
+     * @param instance The object instance
+     * @param member_function Member function to connect
+     * @param priority Priority of the connection (lower value means higher priority)
+     * @return A connection object that manages the connection's lifetime
+     */
+    template<typename T>
+    [[nodiscard]] connection connect(T *instance, void (T::*member_function)(Args...), int64_t priority = 0)
+    {
+        return connect([instance, member_function](Args... args) { (instance->*member_function)(std::forward<Args>(args)...); }, priority);
+    }
+
+    /**
+     * @brief Disconnects all slots from this signal
+     */
+    virtual void clear()
+    {
+        std::scoped_lock lock(_connect_lock, _index_lock);
+
+        _slot_index.clear();
+        _snapshot.store(nullptr, std::memory_order_release);
+    }
+
+    /**
+     * @brief Gets the number of slots connected to this signal
+     * @return Number of connected slots
+     */
+    virtual size_t size() const override
+    {
+        auto snapshot { _snapshot.load(std::memory_order_acquire) };
+
+        return snapshot ? std::size(*snapshot) : 0;
+    }
+
+    /**
+     * @brief Sets the name of this signal
+     * @param name The new name
+     */
+    void name(const std::u8string &name)
+    {
+        std::unique_lock<std::shared_mutex> lock { _name_lock };
+
+        _name = name;
+    }
+
+    /**
+     * @brief Gets the name of this signal
+     * @return The signal's name
+     */
+    virtual std::u8string_view name() const override
+    {
+        std::shared_lock<std::shared_mutex> lock { _name_lock };
+
+        return _name;
+    }
+
+    /**
+     * @brief Sets whether this signal is enabled
+     * @param enabled true to enable the signal, false to disable it
+     */
+    virtual void set_enabled(bool enabled) override
+    {
+        _enabled = enabled;
+    }
+
+    /**
+     * @brief Checks if this signal is enabled
+     * @return true if the signal is enabled, false otherwise
+     */
+    virtual bool is_enabled() const override
+    {
+        return _enabled;
+    }
+
+    /**
+     * @brief Gets this signal's payload
+     * @return Reference to the signal's payload
+     */
+    virtual std::any &payload() override
+    {
+        return _payload;
+    }
+
+    /**
+     * @brief Enables or disables a slot
+     * @param slot The slot to enable/disable
+     * @param enabled true to enable the slot, false to disable it
+     */
+    virtual void enable_slot(const slot_base &slot, bool enabled) override
+    {
+        enable_slot(slot._id, enabled);
+    }
+
+    /**
+     * @brief Enables or disables a slot by its connection
+     * @param s The connection to the slot
+     * @param enabled true to enable the slot, false to disable it
+     */
+    virtual void enable_slot(const paired_ptr<> &s, bool enabled) override
+    {
+        std::shared_lock<std::shared_mutex> lock { _index_lock };
+
+        if (auto s_ptr = find_slot(s); s_ptr != nullptr) s_ptr->set_enabled(enabled);
+    }
+
+    /**
+     * @brief Enables or disables a slot by its handle
+     * @param id The handle of the slot
+     * @param enabled true to enable the slot, false to disable it
+     */
+    virtual void enable_slot(slot_id id, bool enabled) override
+    {
+        std::shared_lock<std::shared_mutex> lock { _index_lock };
+
+        if (auto s_ptr = find_slot(id); s_ptr != nullptr) s_ptr->set_enabled(enabled);
+    }
+
+    /**
+     * @brief Checks if a slot is enabled
+     * @param slot The slot to check
+     * @return true if the slot is enabled, false otherwise
+     */
+    virtual bool is_slot_enabled(const slot_base &slot) const override
+    {
+        return is_slot_enabled(slot._id);
+    }
+
+    /**
+     * @brief Checks if a slot is enabled by its connection
+     * @param slot The connection to the slot
+     * @return true if the slot is enabled, false otherwise
+     */
+    virtual bool is_slot_enabled(const paired_ptr<> &slot) const override
+    {
+        std::shared_lock<std::shared_mutex> lock { _index_lock };
+
+        if (auto s_ptr = find_slot(slot); s_ptr != nullptr) return s_ptr->is_enabled();
+
+        return false;
+    }
+
+    /**
+     * @brief Checks if a slot is enabled by its handle
+     * @param id The handle of the slot
+     * @return true if the slot is enabled, false otherwise
+     */
+    virtual bool is_slot_enabled(slot_id id) const override
+    {
+        std::shared_lock<std::shared_mutex> lock { _index_lock };
+
+        if (auto s_ptr = find_slot(id); s_ptr != nullptr) return s_ptr->is_enabled();
+
+        return false;
+    }
+
+    /**
+     * @brief Gets the priority of a connection
+     * @param con The connection to check
+     * @return The priority of the connection
+     */
+    virtual int64_t get_connection_priority(const paired_ptr<>& con) const override
+    {
+        std::shared_lock<std::shared_mutex> lock { _index_lock };
+
+        if (auto s_ptr = find_slot(con); s_ptr != nullptr) return s_ptr->get_priority();
+
+        return {};
+    }
+
+    /**
+     * @brief Gets the priority of a slot by its handle
+     * @param id The handle of the slot
+     * @return The priority of the slot
+     */
+    virtual int64_t get_connection_priority(slot_id id) const override
+    {
+        std::shared_lock<std::shared_mutex> lock { _index_lock };
+
+        if (auto s_ptr = find_slot(id); s_ptr != nullptr) return s_ptr->get_priority();
+
+        return {};
+    }
+
+    /**
+     * @brief Sets the priority of a connection
+     * 
+     * A re-sorted snapshot is published, so the new priority takes effect on the next emission.
+     * 
+     * @param con The connection to modify
+     * @param priority The new priority
+     * @return true if the priority was set successfully, false otherwise
+     */
+    virtual bool set_connection_priority(const paired_ptr<>& con, int64_t priority) override
+    {
+        std::scoped_lock lock(_connect_lock, _index_lock);
+
+        return set_slot_priority(find_slot(con), priority);
+    }
+
+    /**
+     * @brief Sets the priority of a slot by its handle
+     * 
+     * A re-sorted snapshot is published, so the new priority takes effect on the next emission.
+     * 
+     * @param id The handle of the slot
+     * @param priority The new priority
+     * @return true if the priority was set successfully, false otherwise
+     */
+    virtual bool set_connection_priority(slot_id id, int64_t priority) override
+    {
+        std::scoped_lock lock(_connect_lock, _index_lock);
+
+        return set_slot_priority(find_slot(id), priority);
+    }
+
+protected:
+    std::u8string _name {};
+    std::atomic<snapshot_ptr> _snapshot {};
+    slot_index<slot_type*> _slot_index {};
+    mutable std::mutex _connect_lock {};
+    mutable std::shared_mutex _name_lock {}, _index_lock {};
+    mutable std::atomic_bool _enabled { true };
+    std::atomic<std::shared_ptr<const executor_type>> _executor {};
+    std::any _payload;
+    static inline const executor_type _no_executor {};
+
+    /**
+     * @brief Invokes all enabled slots of the current snapshot in order of their priority
+     * 
+     * If disconnected slots are found, a pruned snapshot is published unless another
+     * writer holds the writer lock. An invoker taking a second, bool argument is told
+     * whether the slot is the last one to be invoked.
+     * 
+     * @param invoker Function invoking a single slot
+     */
+    template<typename Invoker>
+    void dispatch(Invoker &&invoker)
+    {
+        auto snapshot { _snapshot.load(std::memory_order_acquire) };
+
+        if (!snapshot) return;
+
+        bool has_disconnected { false };
+        [[maybe_unused]] const slot_type *last { nullptr };
+
+        if constexpr (std::invocable<Invoker&, const slot_type&, bool>)
+        {
+            auto found { std::find_if(std::rbegin(*snapshot), std::rend(*snapshot), [](const slot_ptr &s){ return !s->is_disconnected() && s->is_enabled(); }) };
+
+            if (found != std::rend(*snapshot)) last = found->get();
+        }
+
+        for (auto &&callable : *snapshot)
+        {
+            if (callable->is_disconnected()) { has_disconnected = true; continue; }
+
+            if (callable->is_enabled())
+            {
+                if constexpr (std::invocable<Invoker&, const slot_type&, bool>) invoker(*callable, callable.get() == last);
+                else invoker(*callable);
+            }
+
+            if (callable->is_disconnected()) has_disconnected = true;
+        }
+
+        if (has_disconnected)
+        {
+            std::unique_lock lock(_connect_lock, std::try_to_lock);
+
+            if (lock.owns_lock())
+            {
+                std::unique_lock<std::shared_mutex> lock_index { _index_lock };
+
+                publish(copy_snapshot());
+            }
+        }
+    }
+
+    /**
+     * @brief Publishes a snapshot extended by a new slot
+     * @param new_slot The slot to connect
+     * @return A connection object that manages the connection's lifetime
+     */
+    connection connect_slot(slot_ptr &&new_slot)
+    {
+        std::scoped_lock lock(_connect_lock);
+        std::unique_lock<std::shared_mutex> lock_index { _index_lock };
+
+        new_slot->_id = _slot_index.acquire(new_slot.get());
+
+        connection con { this, *new_slot };
+        auto slots { copy_snapshot() };
+        auto position { std::upper_bound(std::begin(slots), std::end(slots), new_slot, [](const slot_ptr &l, const slot_ptr &r){ return *l < *r; }) };
+
+        slots.insert(position, std::move(new_slot));
+
+        publish(std::move(slots));
+
+        return con;
+    }
+
+    /**
+     * @brief Copies the current snapshot, dropping disconnected slots
+     * 
+     * The handles of the dropped slots are invalidated. The caller must hold the
+     * writer lock and the index lock exclusively.
+     * 
+     * @return A mutable copy of the current snapshot
+     */
+    snapshot_type copy_snapshot()
+    {
+        snapshot_type slots;
+        auto snapshot { _snapshot.load(std::memory_order_acquire) };
+
+        if (snapshot)
+        {
+            slots.reserve(std::size(*snapshot) + 1);
+
+            for (auto &&s : *snapshot)
+            {
+                if (s->is_disconnected()) _slot_index.release(s->_id);
+                else slots.push_back(s);
+            }
+        }
+
+        return slots;
+    }
+
+    /**
+     * @brief Publishes a new snapshot for subsequent emissions
+     * @param slots The slots of the new snapshot
+     */
+    void publish(snapshot_type &&slots)
+    {
+        _snapshot.store(std::empty(slots) ? nullptr : std::make_shared<const snapshot_type>(std::move(slots)), std::memory_order_release);
+    }
+
+    /**
+     * @brief Sets the priority of a slot and publishes a re-sorted snapshot
+     * 
+     * The caller must hold the writer lock and the index lock exclusively.
+     * 
+     * @param s_ptr The slot to modify
+     * @param priority The new priority
+     * @return true if the priority was set successfully, false otherwise
+     */
+    bool set_slot_priority(slot_type *s_ptr, int64_t priority)
+    {
+        if (s_ptr == nullptr) return false;
+
+        if (s_ptr->set_priority(priority) == priority) return true;
+
+        auto slots { copy_snapshot() };
+
+        std::stable_sort(std::begin(slots), std::end(slots), [](const slot_ptr &l, const slot_ptr &r){ return *l < *r; });
+
+        publish(std::move(slots));
+
+        return true;
+    }
+
+    /**
+     * @brief Finds a slot by its handle
+     * 
+     * The caller must hold the index lock.
+     * 
+     * @param id The handle of the slot
+     * @return Pointer to the slot if found, nullptr otherwise
+     */
+    slot_type* find_slot(slot_id id) const
+    {
+        auto s_ptr { _slot_index.find(id) };
+
+        return s_ptr ? *s_ptr : nullptr;
+    }
+
+    /**
+     * @brief Finds a slot by its connection
+     * 
+     * The caller must hold the index lock.
+     * 
+     * @param con The connection to find
+     * @return Pointer to the slot if found, nullptr otherwise
+     */
+    slot_type* find_slot(const paired_ptr<>& con) const
+    {
+        auto base { slot_base::from_connection(con) };
+
+        if (base == nullptr) return nullptr;
+
+        auto s_ptr { find_slot(base->_id) };
+
+        return (s_ptr != nullptr && *s_ptr == con) ? s_ptr : nullptr;
+    }
+};
+
+/**
+ * @brief Policy applied when an emission is queued into a full signal queue
+ */
+enum class overflow_policy
+{
+    block,          ///< Wait until the consumer makes room
+    drop_newest,    ///< Discard the new emission
+    drop_oldest,    ///< Discard the oldest queued emission
+    coalesce_by_key ///< Replace the queued emission with the same key, or discard the oldest one if there is none
+};
+
+/**
+ * @brief A FIFO of pending emissions with an optional capacity
+ * 
+ * The queue does not lock by itself; the owning signal guards it with its own mutex
+ * and passes the lock in when pushing, so that a blocked producer can release it.
+ * A capacity of zero means the queue is unbounded.
+ * 
+ * @tparam Args Types of the queued arguments
+ */
+template<typename... Args>
+class signal_queue
+{
+public:
+    using value_type = std::tuple<Args...>;
+    using key_functor = small_function<size_t (const Args &...)>;
+
+    /**
+     * @brief Queues an emission, applying the overflow policy if the queue is full
+     * @param lock The caller's lock on the mutex guarding the queue
+     * @param args Arguments to queue; rvalues are moved into the queue
+     * @return true if the emission was queued or coalesced, false if it was dropped
+     */
+    template<typename... T>
+    requires std::constructible_from<value_type, T...>
+    bool push(std::unique_lock<std::mutex> &lock, T &&... args)
+    {
+        if (is_full())
+        {
+            switch (_policy.load())
+            {
+            case overflow_policy::block:
+                _not_full.wait(lock, [this]{ return !is_full(); });
+                break;
+
+            case overflow_policy::drop_newest:
+                ++_dropped;
+                return false;
+
+            case overflow_policy::coalesce_by_key:
+                if (auto it { find_key(args...) }; it != std::end(_items))
+                {
+                    *it = value_type(std::forward<T>(args)...);
+
+                    ++_coalesced;
+
+                    return true;
+                }
+                [[fallthrough]];
+
+            case overflow_policy::drop_oldest:
+                _items.pop_front();
+
+                ++_dropped;
+                break;
+            }
+        }
+
+        _items.emplace_back(std::forward<T>(args)...);
+
+        return true;
+    }
+
+    /**
+     * @brief Removes the oldest emission
+     */
+    void pop_front()
+    {
+        _items.pop_front();
+        _not_full.notify_one();
+    }
+
+    /**
+     * @brief Removes all emissions
+     */
+    void clear()
+    {
+        _items.clear();
+        _not_full.notify_all();
+    }
+
+    value_type &front() { return _items.front(); }
+    value_type &back() { return _items.back(); }
+    auto begin() { return std::begin(_items); }
+    auto end() { return std::end(_items); }
+    bool empty() const noexcept { return std::empty(_items); }
+    size_t size() const noexcept { return std::size(_items); }
+
+    /**
+     * @brief Sets the capacity and the overflow policy
+     * 
+     * Must be called with the guarding mutex locked.
+     * 
+     * @param capacity Maximum number of queued emissions, zero for unbounded
+     * @param policy The policy applied when the queue is full
+     */
+    void set_capacity(size_t capacity, overflow_policy policy)
+    {
+        _capacity = capacity;
+        _policy = policy;
+
+        _not_full.notify_all();
+    }
+
+    size_t get_capacity() const noexcept { return _capacity; }
+    overflow_policy get_overflow_policy() const noexcept { return _policy; }
+
+    /**
+     * @brief Sets the functor computing the coalescing key of an emission
+     * 
+     * Without a key functor all emissions share the same key. Must be called with the guarding mutex locked.
+     * 
+     * @param key The key functor
+     */
+    void set_coalesce_key(key_functor &&key)
+    {
+        _key = std::move(key);
+    }
+
+    uint64_t get_dropped_count() const noexcept { return _dropped; }
+    uint64_t get_coalesced_count() const noexcept { return _coalesced; }
+
+private:
+    std::deque<value_type> _items {};
+    std::condition_variable _not_full {};
+    std::atomic_size_t _capacity { 0 };
+    std::atomic<overflow_policy> _policy { overflow_policy::block };
+    std::atomic_uint64_t _dropped { 0 }, _coalesced { 0 };
+    key_functor _key {};
+
+    bool is_full() const noexcept
+    {
+        auto capacity { _capacity.load() };
+
+        return capacity > 0 && std::size(_items) >= capacity;
+    }
+
+    auto find_key(const Args &... args)
+    {
+        if (!_key) return std::empty(_items) ? std::end(_items) : std::prev(std::end(_items));
+
+        auto key { _key(args...) };
+
+        return std::find_if(std::begin(_items), std::end(_items), [this, key](const value_type &item){ return std::apply(_key, item) == key; });
+    }
+};
+
+/**
+ * @brief An asynchronous stream of the emissions of a signal
+ * 
+ * The stream connects to a signal and buffers its emissions until a coroutine takes
+ * them with co_await stream.next(). A coroutine already awaiting is resumed directly
+ * from the slot, on the emitting thread, without buffering the emission; it must not
+ * emit the streamed signal synchronously before its next suspension. The buffer can be
+ * bounded like the queues of bridged signals.
+ * 
+ * @tparam Args Types of arguments of the streamed signal
+ */
+template<typename... Args>
+class emission_stream
+{
+public:
+    /**
+     * @brief Awaiter of the next emission of a stream
+     */
+    class awaiter : public emission_awaiter<Args...>
+    {
+    public:
+        /**
+         * @brief Constructor
+         * @param stream The stream to await
+         */
+        explicit awaiter(emission_stream &stream) noexcept : _stream{ &stream } {}
+
+        /**
+         * @brief Destructor that stops awaiting if the coroutine is destroyed while suspended
+         */
+        ~awaiter()
+        {
+            if (!this->_linked) return;
+
+            std::scoped_lock lock(_stream->_lock);
+
+            _stream->_awaiters.remove(*this);
+        }
+
+        bool await_ready() const noexcept { return false; }
+
+        /**
+         * @brief Takes a buffered emission, or suspends the coroutine until the next one
+         * @param handle The awaiting coroutine
+         * @return false if the coroutine continues without suspending
+         */
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            std::scoped_lock lock(_stream->_lock);
+
+            if (_stream->take(this->_value) || _stream->_closed) return false;
+
+            _stream->_awaiters.push_back(*this, handle);
+
+            return true;
+        }
+
+    private:
+        emission_stream *_stream;
+    };
+
+    /**
+     * @brief Constructor connecting the stream to a signal
+     * @param s The signal to stream
+     * @param capacity Maximum number of buffered emissions, zero for unbounded
+     * @param policy The policy applied when the buffer is full
+     */
+    template<typename Signal>
+    explicit emission_stream(Signal &s, size_t capacity = 0, overflow_policy policy = overflow_policy::drop_oldest)
+    {
+        _queue.set_capacity(capacity, policy);
+        _connection = s.connect([this](const Args &... args){ push(args...); });
+    }
+
+    emission_stream(const emission_stream &other) = delete;
+    emission_stream &operator=(const emission_stream &other) = delete;
+
+    /**
+     * @brief Destructor that disconnects the stream and ends the awaiting coroutines
+     */
+    ~emission_stream()
+    {
+        _connection.disconnect();
+
+        close();
+    }
+
+    /**
+     * @brief Awaits the next emission
+     * 
+     * Buffered emissions are returned in order without suspending. Once the stream is
+     * closed and its buffer is drained, the result is an empty value.
+     * 
+     * @return The awaiter to co_await
+     */
+    [[nodiscard]] awaiter next() noexcept
+    {
+        return awaiter{ *this };
+    }
+
+    /**
+     * @brief Takes the next buffered emission without waiting
+     * @return The arguments of the emission, or an empty value if none is buffered
+     */
+    std::optional<std::tuple<Args...>> try_next()
+    {
+        std::optional<std::tuple<Args...>> value;
+
+        std::scoped_lock lock(_lock);
+
+        take(value);
+
+        return value;
+    }
+
+    /**
+     * @brief Disconnects the stream; awaiting coroutines are resumed with an empty value
+     */
+    void close()
+    {
+        emission_awaiter<Args...> *awaiters;
+
+        {
+            std::scoped_lock lock(_lock);
+
+            _closed = true;
+            awaiters = _awaiters.take_all();
+        }
+
+        _connection.disconnect();
+
+        awaiter_list<Args...>::end_all(awaiters);
+    }
+
+    /**
+     * @brief Gets the number of buffered emissions
+     * @return Number of buffered emissions
+     */
+    size_t size() const
+    {
+        std::scoped_lock lock(_lock);
+
+        return std::size(_queue);
+    }
+
+    /**
+     * @brief Gets the number of emissions dropped because the buffer was full
+     * @return Number of dropped emissions
+     */
+    uint64_t get_dropped_count() const noexcept
+    {
+        return _queue.get_dropped_count();
+    }
+
+protected:
+    mutable std::mutex _lock {};
+    signal_queue<Args...> _queue {};
+    awaiter_list<Args...> _awaiters {};
+    bool _closed { false };
+    connection _connection {};
+
+    /**
+     * @brief Hands an emission over to the oldest awaiting coroutine, or buffers it
+     */
+    void push(const Args &... args)
+    {
+        std::unique_lock lock(_lock);
+
+        if (_closed) return;
+
+        if (auto waiting { _awaiters.pop_front() })
+        {
+            lock.unlock();
+
+            awaiter_list<Args...>::resume(*waiting, args...);
+
+            return;
+        }
+
+        _queue.push(lock, args...);
+    }
+
+    /**
+     * @brief Takes the oldest buffered emission; the lock must be held
+     * @return true if an emission was buffered, false otherwise
+     */
+    bool take(std::optional<std::tuple<Args...>> &value)
+    {
+        if (std::empty(_queue)) return false;
+
+        value.emplace(std::move(_queue.front()));
+
+        _queue.pop_front();
+
+        return true;
+    }
+};
+
+/**
+ * @brief Checks if a signal type records metrics
+ */
+template<typename Signal>
+inline constexpr bool is_instrumented_v { requires { requires Signal::instrumentation_policy::enabled; } };
+
+/**
+ * @brief Publishes the queue gauges of a signal to its metrics for as long as it is alive
+ * 
+ * Must be the last member of the signal, so that the gauges are removed before the
+ * queue they read is destroyed. It is empty for signals that are not instrumented.
+ * 
+ * @tparam Enabled Whether the signal is instrumented
+ */
+template<bool Enabled>
+class queue_gauges
+{
+public:
+    template<typename Depth, typename Dropped, typename Coalesced>
+    queue_gauges(signal_base*, Depth&&, Dropped&&, Coalesced&&) noexcept {}
+};
+
+template<>
+class queue_gauges<true>
+{
+public:
+    /**
+     * @brief Constructor publishing the gauges
+     * @param s The instrumented signal
+     * @param depth Function reading the number of queued emissions
+     * @param dropped Function reading the number of dropped emissions
+     * @param coalesced Function reading the number of coalesced emissions
+     */
+    queue_gauges(signal_base *s, signal_metrics::gauge_type depth, signal_metrics::gauge_type dropped, signal_metrics::gauge_type coalesced) : _metrics{ s->metrics() }
+    {
+        if (!_metrics) return;
+
+        _metrics->set_gauge(signal_metrics::gauge::queue_depth, std::move(depth));
+        _metrics->set_gauge(signal_metrics::gauge::dropped, std::move(dropped));
+        _metrics->set_gauge(signal_metrics::gauge::coalesced, std::move(coalesced));
+    }
+
+    queue_gauges(const queue_gauges &other) = delete;
+    queue_gauges &operator=(const queue_gauges &other) = delete;
+
+    /**
+     * @brief Destructor removing the gauges
+     */
+    ~queue_gauges()
+    {
+        if (!_metrics) return;
+
+        for (size_t kind = 0; kind < signal_metrics::gauge_count; ++kind) _metrics->set_gauge(static_cast<signal_metrics::gauge>(kind), nullptr);
+    }
+
+private:
+    signal_metrics *_metrics;
+};
+
+/**
+ * @brief Base class for bridged signals
+ * 
+ * A bridged signal queues emitted signals and allows controlling when they are
+ * actually delivered to the slots.
+ * 
+ * @tparam signal_type The signal type to bridge
+ * @tparam Args Types of arguments the signal passes to slots
+ */
+template<template <typename...> typename signal_type, std::movable... Args>
+requires std::derived_from<signal_type<Args...>, signal_base>
+class bridged_signal_base : public signal_type<Args...>
+{
+public:
+    using base_class = signal_type<Args...>;
+    using bridged_signal_type = bridged_signal_base;
+
+    /**
+     * @brief Default constructor
+     */
+    bridged_signal_base() = default;
+    
+    /**
+     * @brief Constructor with a name
+     * @param name The name of the signal
+     */
+    bridged_signal_base(const std::u8string &name) : base_class { name } {}
+    
+    /**
+     * @brief Constructor with a name and emit functor
+     * @param name The name of the signal
+     * @param emit_functor Function to call when signal is emitted
+     */
+    bridged_signal_base(const std::u8string &name, const std::function<bool(bridged_signal_base*)>& emit_functor) : base_class { name }, _emit_functor { emit_functor } {}
+    
+    /**
+     * @brief Constructor with emit functor
+     * @param emit_functor Function to call when signal is emitted
+     */
+    bridged_signal_base(const std::function<bool(bridged_signal_base*)>& emit_functor) : bridged_signal_base { std::u8string {}, emit_functor } {}
+    
+    /**
+     * @brief Constructor with a name and bridge enabled flag
+     * @param name The name of the signal
+     * @param bridge_enabled Whether the bridge is enabled
+     */
+    bridged_signal_base(const std::u8string &name, bool bridge_enabled) : base_class { name }, _bridge_enabled { bridge_enabled } {}
+    
+    /**
+     * @brief Constructor with bridge enabled flag
+     * @param bridge_enabled Whether the bridge is enabled
+     */
+    bridged_signal_base(bool bridge_enabled) : bridged_signal_base { std::u8string {}, bridge_enabled } {}
+
+    /**
+     * @brief Constructor with a name and a bounded queue
+     * @param name The name of the signal
+     * @param capacity Maximum number of queued emissions, zero for unbounded
+     * @param policy The policy applied when the queue is full
+     */
+    bridged_signal_base(const std::u8string &name, size_t capacity, overflow_policy policy) : base_class { name }
+    {
+        set_capacity(capacity, policy);
+    }
+    
+    /**
+     * @brief Move constructor
+     * @param other The signal to move from
+     */
+    bridged_signal_base(bridged_signal_base &&other) noexcept = default;
+    
+    /**
+     * @brief Move assignment operator
+     * @param other The signal to move from
+     * @return Reference to this signal
+     */
+    bridged_signal_base &operator=(bridged_signal_base &&other) noexcept = default;
+    
+    /**
+     * @brief Virtual destructor that waits for a running drain posted by bridge_to and cancels the pending one
+     */
+    virtual ~bridged_signal_base() override
+    {
+        detach_drain();
+    }
+
+    /**
+     * @brief Emits the signal with the given arguments
+     * 
+     * If bridging is enabled, the signal is queued instead of immediately delivered.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit(const Args&... args)
+    {
+        emit_forwarded(args...);
+    }
+
+    /**
+     * @brief Emits the signal with arguments that are moved into the queue
+     * 
+     * Queued arguments are moved on to the slots when they are delivered, see signal::emit.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit(Args&&... args) requires (sizeof...(Args) > 0)
+    {
+        emit_forwarded(std::move(args)...);
+    }
+
+    /**
+     * @brief Function call operator to emit the signal
+     * @param args Arguments to pass to the slots
+     */
+    void operator() (const Args&... args)
+    {
+        emit(args...);
+    }
+
+    /**
+     * @brief Function call operator to emit the signal with arguments that are moved into the queue
+     * @param args Arguments to pass to the slots
+     */
+    void operator() (Args&&... args) requires (sizeof...(Args) > 0)
+    {
+        emit(std::move(args)...);
+    }
+
+    /**
+     * @brief Emits the signal synchronously, bypassing bridging
+     * @param args Arguments to pass to the slots
+     */
+    void emit_sync(const Args&... args)
+    {
+        base_class::emit(args...);
+    }
+
+    /**
+     * @brief Emits the signal synchronously with arguments that may be moved from, bypassing bridging
+     * @param args Arguments to pass to the slots
+     */
+    void emit_sync(Args&&... args) requires (sizeof...(Args) > 0)
+    {
+        base_class::emit(std::move(args)...);
+    }
+
+    /**
+     * @brief Invokes the next queued signal emission
+     * @return true if there are more signals in the queue, false otherwise
+     */
+    virtual bool invoke_next()
+    {
+        if (std::empty(_signal_queue)) return false;
+
+        std::scoped_lock lock(_queue_lock);
+
+        if (std::empty(_signal_queue)) return false;
+
+        std::apply([this](Args&... a){ base_class::emit(std::move(a)...); }, _signal_queue.front());
+
+        _signal_queue.pop_front();
+
+        return !std::empty(_signal_queue);
+    }
+
+    /**
+     * @brief Invokes all queued signal emissions
+     */
+    virtual void invoke_all()
+    {
+        if (std::empty(_signal_queue)) return;
+
+        std::scoped_lock lock(_queue_lock);
+
+        if (std::empty(_signal_queue)) return;
+
+        for (auto &&args : _signal_queue) std::apply([this](Args&... a){ base_class::emit(std::move(a)...); }, args);
+
+        _signal_queue.clear();
+    }
+
+    /**
+     * @brief Invokes only the last queued signal emission and clears the queue
+     */
+    virtual void invoke_last_and_clear()
+    {
+        if (std::empty(_signal_queue)) return;
+
+        std::scoped_lock lock(_queue_lock);
+
+        if (std::empty(_signal_queue)) return;
+
+        std::apply([this](Args&... a){ base_class::emit(std::move(a)...); }, _signal_queue.back());
+
+        _signal_queue.clear();
+    }
+
+    /**
+     * @brief Sets the emit functor
+     * @param emit_functor Function to call when signal is emitted
+     */
+    void set_emit_functor(const std::function<bool(bridged_signal_base*)>& emit_functor)
+    {
+        _emit_functor = emit_functor;
+    }
+
+    /**
+     * @brief Bridges the signal to an executor, such as a strand or an event_loop_strand
+     * 
+     * Replaces the emit functor with one that posts a drain task to the executor. At most
+     * one drain task is posted at a time; it delivers all emissions queued by then in a
+     * batch, in the order they were emitted, while emitting threads only wait for the
+     * emissions to be taken out of the queue. Tasks posted for a destroyed signal or
+     * after the bridge has been changed do nothing.
+     * 
+     * @param executor The executor running the deliveries
+     */
+    void bridge_to(executor_type executor)
+    {
+        detach_drain();
+
+        auto state { std::make_shared<drain_state>() };
+
+        state->owner = this;
+
+        _emit_functor = [executor = std::move(executor), state = std::weak_ptr{ state }](bridged_signal_base*)
+        {
+            auto shared_state { state.lock() };
+
+            if (!shared_state || shared_state->posted.exchange(true)) return true;
+
+            try
+            {
+                executor([state]
+                {
+                    auto shared_state { state.lock() };
+
+                    if (!shared_state) return;
+
+                    std::scoped_lock lock(shared_state->lock);
+
+                    shared_state->posted = false;
+
+                    if (shared_state->owner) shared_state->owner->drain_queue();
+                });
+            }
+            catch (...)
+            {
+                shared_state->posted = false;
+
+                throw;
+            }
+
+            return true;
+        };
+
+        _drain_state = std::move(state);
+    }
+
+    /**
+     * @brief Gets the emit functor
+     * @return The emit functor
+     */
+    const std::function<bool(bridged_signal_base*)> &get_emit_functor() const noexcept
+    {
+        return _emit_functor;
+    }
+
+    /**
+     * @brief Gets the size of the signal queue
+     * @return Number of queued signal emissions
+     */
+    uint64_t get_queue_size() const
+    {
+        std::scoped_lock lock(_queue_lock);
+
+        return std::size(_signal_queue);
+    }
+
+    /**
+     * @brief Sets whether bridging is enabled
+     * @param enabled true to enable bridging, false to disable it
+     */
+    void set_bridge_enabled(bool enabled) noexcept
+    {
+        _bridge_enabled.store(enabled);
+    }
+
+    /**
+     * @brief Checks if bridging is enabled
+     * @return true if bridging is enabled, false otherwise
+     */
+    bool get_bridge_enabled() const noexcept
+    {
+        return _bridge_enabled;
+    }
+
+    /**
+     * @brief Clears the signal queue
+     */
+    void clear_queue()
+    {
+        if (std::empty(_signal_queue)) return;
+
+        std::scoped_lock lock(_queue_lock);
+
+        if (std::empty(_signal_queue)) return;
+
+        _signal_queue.clear();
+    }
+
+    /**
+     * @brief Bounds the signal queue
+     * 
+     * With the block policy, emit waits until another thread invokes the queued emissions.
+     * 
+     * @param capacity Maximum number of queued emissions, zero for unbounded
+     * @param policy The policy applied when the queue is full
+     */
+    void set_capacity(size_t capacity, overflow_policy policy = overflow_policy::drop_oldest)
+    {
+        std::scoped_lock lock(_queue_lock);
+
+        _signal_queue.set_capacity(capacity, policy);
+    }
+
+    /**
+     * @brief Gets the capacity of the signal queue
+     * @return Maximum number of queued emissions, zero if unbounded
+     */
+    size_t get_capacity() const noexcept
+    {
+        return _signal_queue.get_capacity();
+    }
+
+    /**
+     * @brief Gets the overflow policy of the signal queue
+     * @return The policy applied when the queue is full
+     */
+    overflow_policy get_overflow_policy() const noexcept
+    {
+        return _signal_queue.get_overflow_policy();
+    }
+
+    /**
+     * @brief Sets the functor computing the key used by the coalesce_by_key policy
+     * @param key Functor returning the key of an emission
+     */
+    void set_coalesce_key(typename signal_queue<Args...>::key_functor &&key)
+    {
+        std::scoped_lock lock(_queue_lock);
+
+        _signal_queue.set_coalesce_key(std::move(key));
+    }
+
+    /**
+     * @brief Gets the number of emissions dropped because the queue was full
+     * @return Number of dropped emissions
+     */
+    uint64_t get_dropped_count() const noexcept
+    {
+        return _signal_queue.get_dropped_count();
+    }
+
+    /**
+     * @brief Gets the number of emissions merged into a queued one with the same key
+     * @return Number of coalesced emissions
+     */
+    uint64_t get_coalesced_count() const noexcept
+    {
+        return _signal_queue.get_coalesced_count();
+    }
+
+protected:
+    /**
+     * @brief State shared between a signal bridged to an executor and its drain tasks
+     */
+    struct drain_state
+    {
+        std::mutex lock {};
+        bridged_signal_base *owner { nullptr };
+        std::atomic_bool posted { false };
+    };
+
+    std::atomic_bool _bridge_enabled { true };
+    mutable std::mutex _queue_lock {};
+    signal_queue<Args...> _signal_queue {};
+    std::function<bool(bridged_signal_base*)> _emit_functor { nullptr };
+    std::shared_ptr<drain_state> _drain_state {};
+    std::vector<std::tuple<Args...>> _drain_batch {};
+    [[no_unique_address]] queue_gauges<is_instrumented_v<base_class>> _queue_gauges { this,
+        [this]{ return get_queue_size(); },
+        [this]{ return get_dropped_count(); },
+        [this]{ return get_coalesced_count(); } };
+
+    /**
+     * @brief Delivers all queued emissions; called by the drain task posted by bridge_to
+     * 
+     * The emissions are moved out of the queue before they are delivered, so the queue
+     * is not locked while the slots run. If a slot throws, the rest of the batch is dropped.
+     */
+    void drain_queue()
+    {
+        {
+            std::scoped_lock lock(_queue_lock);
+
+            for (; !std::empty(_signal_queue); _signal_queue.pop_front()) _drain_batch.push_back(std::move(_signal_queue.front()));
+        }
+
+        try
+        {
+            for (auto &&args : _drain_batch) std::apply([this](Args&... a){ base_class::emit(std::move(a)...); }, args);
+        }
+        catch (...)
+        {
+            _drain_batch.clear();
+
+            throw;
+        }
+
+        _drain_batch.clear();
+    }
+
+    /**
+     * @brief Detaches the drain tasks posted by bridge_to from this signal, waiting for a running one
+     */
+    void detach_drain()
+    {
+        if (!_drain_state) return;
+
+        std::scoped_lock lock(_drain_state->lock);
+
+        _drain_state->owner = nullptr;
+    }
+
+    /**
+     * @brief Queues an emission, or delivers it directly if bridging is disabled
+     * @param args Arguments to pass to the slots
+     */
+    template<typename... T>
+    void emit_forwarded(T&&... args)
+    {
+        if (!base_class::_enabled) return;
+
+        if (_bridge_enabled)
+        {
+            {
+                std::unique_lock lock(_queue_lock);
+
+                if (!_signal_queue.push(lock, std::forward<T>(args)...)) return;
+            }
+
+            if (!_emit_functor || !_emit_functor(this)) invoke_next();
+        }
+        else base_class::emit(std::forward<T>(args)...);
+    }
+};
+
+/**
+ * @brief Type alias for a bridged signal
+ * @tparam Args Types of arguments the signal passes to slots
+ */
+template<typename... Args> using bridged_signal = bridged_signal_base<signal, Args...>;
+
+/**
+ * @brief Type alias for a bridged extended signal
+ * @tparam Args Types of arguments the signal passes to slots
+ */
+template<typename... Args> using bridged_signal_ex = bridged_signal_base<signal_ex, Args...>;
+
+/**
+ * @brief Type alias for a bridged signal that records metrics and publishes its queue gauges
+ * @tparam Args Types of arguments the signal passes to slots
+ */
+template<typename... Args> using instrumented_bridged_signal = bridged_signal_base<instrumented_signal, Args...>;
+
+/**
+ * @brief A hierarchical timer wheel served by a fixed set of dispatcher threads
+ * 
+ * Timers are kept in four levels of 64 buckets each; a clock thread advances the
+ * wheel once per tick, cascades timers down to the finer levels and hands expired
+ * timers over to the dispatcher threads, which run their callbacks. Scheduling and
+ * cancelling are constant time, and the clock thread blocks while no timers are
+ * pending. Deadlines are kept against the wheel's start time, so they do not drift.
+ * 
+ * Each dispatcher thread runs one callback at a time, so a slow callback delays the
+ * timers due behind it. Throttled, rate-limited and coalescing signals deliver to their
+ * slots from these callbacks and share the process-wide wheel by default; give signals
+ * with slow slots a wheel of their own through their constructors.
+ */
+class timer_wheel
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using callback_type = small_function<void()>;
+
+    /**
+     * @brief State of a scheduled timer
+     */
+    enum class timer_state { scheduled, running, done, cancelled };
+
+    /**
+     * @brief A scheduled timer
+     */
+    struct timer
+    {
+        uint64_t deadline { 0 };
+        callback_type callback {};
+        std::atomic<timer_state> state { timer_state::scheduled };
+    };
+
+    using timer_handle = std::shared_ptr<timer>;
+
+    /**
+     * @brief Constructor
+     * @param dispatcher_count Number of threads running the timer callbacks
+     * @param tick The resolution of the wheel
+     */
+    explicit timer_wheel(size_t dispatcher_count = 1, std::chrono::nanoseconds tick = 1ms) : _tick{ std::max(tick, std::chrono::nanoseconds{ 1 }) }
+    {
+        _clock_thread = std::jthread([this]{ clock_procedure(); });
+
+        for (size_t i = 0; i < std::max<size_t>(dispatcher_count, 1); ++i) _dispatcher_threads.emplace_back([this]{ dispatcher_procedure(); });
+    }
+
+    timer_wheel(const timer_wheel &other) = delete;
+    timer_wheel &operator=(const timer_wheel &other) = delete;
+
+    /**
+     * @brief Destructor that stops the threads and drops the pending timers
+     */
+    ~timer_wheel()
+    {
+        {
+            std::scoped_lock lock(_lock);
+
+            _stopping = true;
+        }
+
+        _clock_cv.notify_all();
+        _ready_cv.notify_all();
+        _done_cv.notify_all();
+
+        if (_clock_thread.get_id() == std::this_thread::get_id()) _clock_thread.detach();
+        else if (_clock_thread.joinable()) _clock_thread.join();
+
+        for (auto &thread : _dispatcher_threads) if (thread.joinable()) thread.join();
+    }
+
+    /**
+     * @brief Gets the wheel shared by the whole process
+     * 
+     * The wheel has one dispatcher thread per four hardware threads, at least one and
+     * at most four.
+     * 
+     * @return Reference to the process-wide timer wheel
+     */
+    static timer_wheel &global()
+    {
+        static timer_wheel wheel { std::clamp(std::thread::hardware_concurrency() / 4, 1u, 4u) };
+
+        return wheel;
+    }
+
+    /**
+     * @brief Schedules a callback to run once after a delay
+     * @param delay The delay, rounded up to whole ticks
+     * @param callback The callback to run on a dispatcher thread
+     * @return Handle that can be used to cancel the timer
+     */
+    template<typename Duration>
+    timer_handle schedule(const Duration &delay, callback_type &&callback)
+    {
+        auto new_timer { std::make_shared<timer>() };
+        auto delay_ticks { (std::chrono::duration_cast<std::chrono::nanoseconds>(delay).count() + _tick.count() - 1) / _tick.count() };
+
+        new_timer->callback = std::move(callback);
+
+        {
+            std::scoped_lock lock(_lock);
+
+            if (_stopping) return new_timer;
+
+            if (_pending == 0) _current_tick = elapsed_ticks(clock_type::now());
+
+            new_timer->deadline = _current_tick + static_cast<uint64_t>(std::max<int64_t>(delay_ticks, 0));
+
+            insert(new_timer);
+        }
+
+        _clock_cv.notify_one();
+
+        return new_timer;
+    }
+
+    /**
+     * @brief Cancels a timer
+     * 
+     * If the callback is already running, waits for it to finish, unless it is the
+     * callback calling cancel.
+     * 
+     * @param handle The timer to cancel
+     * @return true if the timer was cancelled before its callback started, false otherwise
      */
-    virtual void enable_slot(const slot_base& slot, bool enabled) = 0;
-    
+    bool cancel(const timer_handle &handle)
+    {
+        if (!handle) return false;
+
+        auto expected { timer_state::scheduled };
+
+        if (handle->state.compare_exchange_strong(expected, timer_state::cancelled)) return true;
+
+        if (expected == timer_state::running && _current_timer != handle.get())
+        {
+            std::unique_lock lock(_lock);
+
+            _done_cv.wait(lock, [&handle]{ return handle->state.load() != timer_state::running; });
+        }
+
+        return false;
+    }
+
     /**
-     * @brief Enables or disables a slot by its connection
-     * @param connection The connection to the slot
-     * @param enabled true to enable the slot, false to disable it
+     * @brief Gets the number of dispatcher threads
+     * @return Number of dispatcher threads
      */
-    virtual void enable_slot(const paired_ptr<>& connection, bool enabled) = 0;
-    
+    size_t dispatcher_count() const noexcept
+    {
+        return std::size(_dispatcher_threads);
+    }
+
     /**
-     * @brief Checks if a slot is enabled
-     * @param slot The slot to check
-     * @return true if the slot is enabled, false otherwise
+     * @brief Gets the resolution of the wheel
+     * @return The duration of a tick
      */
-    virtual bool is_slot_enabled(const slot_base& slot) const = 0;
-    
+    std::chrono::nanoseconds tick() const noexcept
+    {
+        return _tick;
+    }
+
     /**
-     * @brief Checks if a slot is enabled by its connection
-     * @param connection The connection to the slot
-     * @return true if the slot is enabled, false otherwise
+     * @brief Gets the number of timers not handed over to the dispatchers yet
+     * @return Number of pending timers
      */
-    virtual bool is_slot_enabled(const paired_ptr<>& connection) const = 0;
-    
+    size_t size() const
+    {
+        std::scoped_lock lock(_lock);
+
+        return _pending;
+    }
+
+private:
+    static constexpr size_t level_bits { 6 }, level_size { 1 << level_bits }, level_count { 4 };
+    static constexpr uint64_t level_mask { level_size - 1 }, wheel_range { uint64_t{ 1 } << (level_bits * level_count) };
+    static inline thread_local const timer *_current_timer { nullptr };
+
+    const std::chrono::nanoseconds _tick;
+    const clock_type::time_point _start { clock_type::now() };
+    std::array<std::array<std::vector<timer_handle>, level_size>, level_count> _wheel {};
+    std::deque<timer_handle> _ready {};
+    uint64_t _current_tick { 0 };
+    size_t _pending { 0 };
+    bool _stopping { false };
+    mutable std::mutex _lock {};
+    std::condition_variable _clock_cv {}, _ready_cv {}, _done_cv {};
+    std::jthread _clock_thread {};
+    std::vector<std::jthread> _dispatcher_threads {};
+
+    uint64_t elapsed_ticks(clock_type::time_point time_point) const
+    {
+        return static_cast<uint64_t>((time_point - _start) / _tick);
+    }
+
     /**
-     * @brief Gets the priority of a connection
-     * @param connection The connection to check
-     * @return The priority of the connection
+     * @brief Puts a timer into the bucket matching its deadline, or into the ready queue
+     * 
+     * The caller must hold the lock.
      */
-    virtual int64_t get_connection_priority(const paired_ptr<>& connection) const = 0;
-    
+    void insert(timer_handle t)
+    {
+        if (t->deadline <= _current_tick)
+        {
+            _ready.push_back(std::move(t));
+            _ready_cv.notify_one();
+
+            return;
+        }
+
+        auto deadline { std::min(t->deadline, _current_tick + wheel_range - 1) };
+        auto delta { deadline - _current_tick };
+        size_t level { 0 };
+
+        while (level < level_count - 1 && delta >= (uint64_t{ 1 } << (level_bits * (level + 1)))) ++level;
+
+        _wheel[level][(deadline >> (level_bits * level)) & level_mask].push_back(std::move(t));
+
+        ++_pending;
+    }
+
     /**
-     * @brief Sets the priority of a connection
-     * @param connection The connection to modify
-     * @param priority The new priority
-     * @return true if the priority was set successfully, false otherwise
+     * @brief Advances the wheel by one tick
+     * 
+     * The caller must hold the lock.
      */
-    virtual bool set_connection_priority(const paired_ptr<>& connection, int64_t priority) = 0;
+    void advance()
+    {
+        ++_current_tick;
+
+        size_t top_level { 0 };
+
+        while (top_level < level_count - 1 && ((_current_tick >> (level_bits * top_level)) & level_mask) == 0) ++top_level;
+
+        for (auto level { top_level }; level > 0; --level)
+        {
+            auto &bucket { _wheel[level][(_current_tick >> (level_bits * level)) & level_mask] };
+            auto timers { std::move(bucket) };
+
+            bucket.clear();
+            _pending -= std::size(timers);
+
+            for (auto &&t : timers) if (t->state.load() == timer_state::scheduled) insert(std::move(t));
+        }
+
+        auto &bucket { _wheel[0][_current_tick & level_mask] };
+
+        _pending -= std::size(bucket);
+
+        for (auto &&t : bucket) if (t->state.load() == timer_state::scheduled) _ready.push_back(std::move(t));
+
+        bucket.clear();
+
+        if (!std::empty(_ready)) _ready_cv.notify_all();
+    }
+
+    void clock_procedure()
+    {
+        std::unique_lock lock(_lock);
+
+        while (!_stopping)
+        {
+            if (_pending == 0)
+            {
+                _clock_cv.wait(lock, [this]{ return _stopping || _pending > 0; });
+
+                continue;
+            }
+
+            _clock_cv.wait_until(lock, _start + _tick * (_current_tick + 1), [this]{ return _stopping; });
+
+            for (auto now_tick { elapsed_ticks(clock_type::now()) }; !_stopping && _pending > 0 && _current_tick < now_tick;) advance();
+        }
+    }
+
+    void dispatcher_procedure()
+    {
+        while (true)
+        {
+            timer_handle t;
+
+            {
+                std::unique_lock lock(_lock);
+
+                _ready_cv.wait(lock, [this]{ return _stopping || !std::empty(_ready); });
+
+                if (_stopping) return;
+
+                t = std::move(_ready.front());
+
+                _ready.pop_front();
+            }
+
+            auto expected { timer_state::scheduled };
+
+            if (!t->state.compare_exchange_strong(expected, timer_state::running)) continue;
+
+            _current_timer = t.get();
+
+            t->callback();
+
+            _current_timer = nullptr;
+
+            {
+                std::scoped_lock lock(_lock);
+
+                t->state = timer_state::done;
+            }
+
+            _done_cv.notify_all();
+        }
+    }
 };
 
 /**
- * @brief Class representing a connection between a signal and a slot
+ * @brief Base class for throttled signals
  * 
- * This class manages the lifetime of a connection between a signal and a slot.
- * When a connection object is destroyed, the connection is automatically broken.
+ * A throttled signal limits the rate at which signal emissions are delivered to slots.
+ * Deliveries are scheduled on a timer wheel (the process-wide one by default), so
+ * slots are invoked on the wheel's dispatcher threads and no thread is owned by the
+ * signal itself.
+ * 
+ * @tparam signal_type The signal type to throttle
+ * @tparam Args Types of arguments the signal passes to slots
  */
-class connection
+template<template <typename...> typename signal_type, std::movable... Args>
+requires std::derived_from<signal_type<Args...>, signal_base>
+class throttled_signal_base : public signal_type<Args...>
 {
 public:
+    using base_class = signal_type<Args...>;
+
     /**
-     * @brief Default constructor creates an empty connection
+     * @brief Default constructor
      */
-    connection() = default;
+    throttled_signal_base() = default;
+    
+    /**
+     * @brief Constructor with a name and throttle duration
+     * @param name The name of the signal
+     * @param throttle_ms The throttling duration
+     */
+    template<typename Duration>
+    throttled_signal_base(const std::u8string &name, const Duration &throttle_ms = throttled_signal_base::_default_throttle_ms) : base_class{ name }, _throttle_ms{ std::chrono::duration_cast<std::chrono::milliseconds>(throttle_ms) } {}
+    
+    /**
+     * @brief Constructor with a name
+     * @param name The name of the signal
+     */
+    throttled_signal_base(const std::u8string &name) : base_class{ name } {}
 
     /**
-     * @brief Constructor that connects a signal and a slot
-     * @param signal The signal to connect to
-     * @param s The slot to connect
+     * @brief Constructor with a name, throttle duration and the timer wheel to schedule deliveries on
+     * @param name The name of the signal
+     * @param throttle_ms The throttling duration
+     * @param wheel The timer wheel; it must outlive the signal
      */
-    template<typename... Args>
-    connection(const signal_base *signal, slot<Args...> &s) : _connection{ &s._connection }, _signal { signal }
+    template<typename Duration>
+    throttled_signal_base(const std::u8string &name, const Duration &throttle_ms, timer_wheel &wheel) : base_class{ name }, _throttle_ms{ std::chrono::duration_cast<std::chrono::milliseconds>(throttle_ms) }, _timer_wheel{ &wheel } {}
+
+    /**
+     * @brief Constructor with a name, throttle duration and a bounded queue
+     * @param name The name of the signal
+     * @param throttle_ms The throttling duration
+     * @param capacity Maximum number of queued emissions, zero for unbounded
+     * @param policy The policy applied when the queue is full
+     */
+    template<typename Duration>
+    throttled_signal_base(const std::u8string &name, const Duration &throttle_ms, size_t capacity, overflow_policy policy) : throttled_signal_base{ name, throttle_ms }
     {
+        set_capacity(capacity, policy);
     }
-
+    
     /**
      * @brief Move constructor
-     * @param other The connection to move from
+     * @param other The signal to move from
      */
-    connection(connection &&other) noexcept = default;
-    
-    connection(const connection &other) = delete;
-    connection &operator=(const connection &other) = delete;
+    throttled_signal_base(throttled_signal_base &&other) noexcept = default;
     
     /**
      * @brief Move assignment operator
-     * @param other The connection to move from
-     * @return Reference to this connection
+     * @param other The signal to move from
+     * @return Reference to this signal
      */
-    connection &operator=(connection &&other) noexcept
+    throttled_signal_base &operator=(throttled_signal_base &&other) noexcept = default;
+
+    /**
+     * @brief Destructor that optionally dispatches pending signals
+     */
+    virtual ~throttled_signal_base() override
     {
-        disconnect();
+        timer_wheel::timer_handle pending_timer;
 
-        _connection = std::move(other._connection);
-        _signal = std::move(other._signal);
+        {
+            std::scoped_lock lock(_emit_lock);
 
-        return *this;
+            _destroying = true;
+            pending_timer = std::move(_dispatch_timer);
+        }
+
+        _timer_wheel->cancel(pending_timer);
+
+        if (_dispatch_all_on_destroy)
+        {
+            std::scoped_lock lock(_emit_lock);
+
+            while (!std::empty(_signal_queue))
+            {
+                std::apply([this](Args&... a){ base_class::emit(std::move(a)...); }, _signal_queue.front());
+
+                _signal_queue.pop_front();
+            }
+        }
+    }
+
+    /**
+     * @brief Emits the signal with the given arguments
+     * 
+     * Signal emissions are queued and delivered at a controlled rate.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit(const Args &... args)
+    {
+        enqueue(args...);
+    }
+
+    /**
+     * @brief Emits the signal with arguments that are moved into the queue
+     * 
+     * Queued arguments are moved on to the slots when they are delivered, see signal::emit.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit(Args &&... args) requires (sizeof...(Args) > 0)
+    {
+        enqueue(std::move(args)...);
+    }
+
+    /**
+     * @brief Function call operator to emit the signal
+     * @param args Arguments to pass to the slots
+     */
+    void operator() (const Args &... args)
+    {
+        emit(args...);
+    }
+
+    /**
+     * @brief Function call operator to emit the signal with arguments that are moved into the queue
+     * @param args Arguments to pass to the slots
+     */
+    void operator() (Args &&... args) requires (sizeof...(Args) > 0)
+    {
+        emit(std::move(args)...);
+    }
+
+    /**
+     * @brief Sets the throttling duration
+     * @param duration The new throttling duration
+     */
+    template<typename Duration>
+    void throttle_ms(const Duration &duration) noexcept
+    {
+        _throttle_ms.store(std::chrono::duration_cast<std::chrono::milliseconds>(duration));
+    }
+
+    /**
+     * @brief Gets the throttling duration
+     * @return The throttling duration in milliseconds
+     */
+    std::chrono::milliseconds throttle_ms() const noexcept
+    {
+        return _throttle_ms.load();
+    }
+
+    /**
+     * @brief Sets whether all pending signals should be dispatched on destroy
+     * @param do_dispatch true to dispatch all pending signals, false otherwise
+     */
+    void set_dispatch_all_on_destroy(bool do_dispatch) noexcept
+    {
+        _dispatch_all_on_destroy = do_dispatch;
     }
 
     /**
-     * @brief Destructor that ensures the connection is properly disconnected
+     * @brief Checks if all pending signals will be dispatched on destroy
+     * @return true if all pending signals will be dispatched, false otherwise
      */
-    ~connection()
+    bool get_dispatch_all_on_destroy() const noexcept
     {
-        disconnect();
+        return _dispatch_all_on_destroy;
     }
 
     /**
-     * @brief Disconnects the signal from the slot
+     * @brief Bounds the signal queue
+     * @param capacity Maximum number of queued emissions, zero for unbounded
+     * @param policy The policy applied when the queue is full
      */
-    void disconnect() noexcept
+    void set_capacity(size_t capacity, overflow_policy policy = overflow_policy::drop_oldest)
     {
-        if (_connection) _connection.disconnect();
+        std::scoped_lock lock(_emit_lock);
 
-        _signal = nullptr;
+        _signal_queue.set_capacity(capacity, policy);
     }
 
     /**
-     * @brief Checks if the connection is disconnected
-     * @return true if the connection is disconnected, false otherwise
+     * @brief Gets the capacity of the signal queue
+     * @return Maximum number of queued emissions, zero if unbounded
      */
-    [[nodiscard]] bool is_disconnected() const noexcept { return !_connection; }
+    size_t get_capacity() const noexcept
+    {
+        return _signal_queue.get_capacity();
+    }
 
     /**
-     * @brief Gets the signal this connection is connected to
-     * @return Reference to the connected signal
+     * @brief Gets the overflow policy of the signal queue
+     * @return The policy applied when the queue is full
      */
-    [[nodiscard]] const signal_base &signal() const noexcept
+    overflow_policy get_overflow_policy() const noexcept
     {
-        return *_signal;
+        return _signal_queue.get_overflow_policy();
     }
 
     /**
-     * @brief Enables or disables this connection
-     * @param enabled true to enable the connection, false to disable it
+     * @brief Sets the functor computing the key used by the coalesce_by_key policy
+     * @param key Functor returning the key of an emission
      */
-    void set_enabled(bool enabled)
+    void set_coalesce_key(typename signal_queue<Args...>::key_functor &&key)
     {
-        const_cast<signal_base*>(_signal)->enable_slot(_connection, enabled);
+        std::scoped_lock lock(_emit_lock);
+
+        _signal_queue.set_coalesce_key(std::move(key));
     }
 
     /**
-     * @brief Checks if this connection is enabled
-     * @return true if the connection is enabled, false otherwise
+     * @brief Gets the number of emissions dropped because the queue was full
+     * @return Number of dropped emissions
      */
-    [[nodiscard]] bool is_enabled() const
+    uint64_t get_dropped_count() const noexcept
     {
-        return _signal->is_slot_enabled(_connection);
+        return _signal_queue.get_dropped_count();
     }
 
     /**
-     * @brief Gets the priority of this connection
-     * @return The connection's priority
+     * @brief Gets the number of emissions merged into a queued one with the same key
+     * @return Number of coalesced emissions
      */
-    [[nodiscard]] int64_t get_connection_priority() const
+    uint64_t get_coalesced_count() const noexcept
     {
-        return _signal->get_connection_priority(_connection);
+        return _signal_queue.get_coalesced_count();
     }
 
+protected:
+    static inline std::chrono::milliseconds _default_throttle_ms { 10ms };
+    signal_queue<Args...> _signal_queue {};
+    std::mutex _emit_lock {};
+    std::atomic<std::chrono::milliseconds> _throttle_ms { _default_throttle_ms };
+    timer_wheel *_timer_wheel { &timer_wheel::global() };
+    timer_wheel::timer_handle _dispatch_timer {};
+    bool _destroying { false };
+    std::atomic_bool _dispatch_all_on_destroy { true };
+    [[no_unique_address]] queue_gauges<is_instrumented_v<base_class>> _queue_gauges { this,
+        [this]{ std::scoped_lock lock(_emit_lock); return static_cast<uint64_t>(std::size(_signal_queue)); },
+        [this]{ return get_dropped_count(); },
+        [this]{ return get_coalesced_count(); } };
+
     /**
-     * @brief Sets the priority of this connection
-     * @param priority The new priority
-     * @return true if the priority was set successfully, false otherwise
+     * @brief Queues an emission and schedules its delivery
+     * @param args Arguments to pass to the slots
      */
-    bool set_connection_priority(int64_t priority)
+    template<typename... T>
+    void enqueue(T &&... args)
     {
-        return const_cast<signal_base*>(_signal)->set_connection_priority(_connection, priority);
+        std::unique_lock lock(_emit_lock);
+
+        if (!_signal_queue.push(lock, std::forward<T>(args)...)) return;
+
+        if (!_dispatch_timer) _dispatch_timer = _timer_wheel->schedule(0ms, [this]{ dispatch_next(); });
     }
 
-protected:
-    paired_ptr<> _connection {};
-    const signal_base *_signal { nullptr };
+    /**
+     * @brief Timer callback that delivers the next queued emission and reschedules itself while the queue is not empty
+     */
+    void dispatch_next()
+    {
+        std::scoped_lock lock(_emit_lock);
+
+        _dispatch_timer.reset();
+
+        if (_destroying || std::empty(_signal_queue)) return;
+
+        std::apply([this](Args&... a){ base_class::emit(std::move(a)...); }, _signal_queue.front());
+
+        _signal_queue.pop_front();
+
+        if (!std::empty(_signal_queue)) _dispatch_timer = _timer_wheel->schedule(_throttle_ms.load(), [this]{ dispatch_next(); });
+    }
 };
 
 /**
- * @brief The core signal class that can be connected to slots
+ * @brief Type alias for a throttled signal
+ * @tparam Args Types of arguments the signal passes to slots
+ */
+template<typename... Args> using throttled_signal = throttled_signal_base<signal, Args...>;
+
+/**
+ * @brief Type alias for a throttled extended signal
+ * @tparam Args Types of arguments the signal passes to slots
+ */
+template<typename... Args> using throttled_signal_ex = throttled_signal_base<signal_ex, Args...>;
+
+/**
+ * @brief Type alias for a throttled signal that records metrics and publishes its queue gauges
+ * @tparam Args Types of arguments the signal passes to slots
+ */
+template<typename... Args> using instrumented_throttled_signal = throttled_signal_base<instrumented_signal, Args...>;
+
+/**
+ * @brief Base class for rate-limited signals
  * 
- * A signal can have multiple slots connected to it. When the signal is emitted,
- * all connected slots are invoked in order of their priority.
+ * A rate-limited signal queues its emissions and delivers them at a sustained rate,
+ * allowing bursts of up to a given number of deliveries. The rate is enforced by a
+ * token bucket refilled against the steady clock with nanosecond resolution: every
+ * delivery takes a token, and the bucket holds as many tokens as the burst size, or
+ * the tokens collected over two ticks of the wheel if that is more. Deliveries are
+ * scheduled on a timer wheel (the process-wide one by default), immediately while
+ * tokens are left and otherwise for when the next token is due. Wakeups are rounded
+ * up to whole ticks and every one delivers as many queued emissions as there are
+ * tokens, so rates above the resolution of the wheel are sustained in batches. Slots
+ * are invoked on the wheel's dispatcher threads, one delivery at a time and in the
+ * order of emission.
  * 
- * @tparam Args Types of arguments the signal passes to slots when emitted
+ * @tparam signal_type The signal type to rate-limit
+ * @tparam Args Types of arguments the signal passes to slots
  */
-template<typename... Args>
-class signal : public signal_base
+template<template <typename...> typename signal_type, std::movable... Args>
+requires std::derived_from<signal_type<Args...>, signal_base>
+class rate_limited_signal_base : public signal_type<Args...>
 {
 public:
-    using slot_type = slot<Args...>;
-    using slot_container = std::multiset<slot_type, std::less<slot<Args...>>, std::allocator<slot<Args...>>>;
+    using base_class = signal_type<Args...>;
+    using clock_type = std::chrono::steady_clock;
 
     /**
-     * @brief Default constructor
+     * @brief Default constructor; the rate is 1000 deliveries per second without bursts
      */
-    signal() = default;
-    
+    rate_limited_signal_base() = default;
+
     /**
-     * @brief Constructor with a name
+     * @brief Constructor with a name; the rate is 1000 deliveries per second without bursts
      * @param name The name of the signal
      */
-    signal(const std::u8string &name) : _name{ name } {}
-    
-    /**
-     * @brief Move constructor
-     * @param other The signal to move from
-     */
-    signal(signal &&other) noexcept = default;
-    
+    rate_limited_signal_base(const std::u8string &name) : base_class{ name } {}
+
     /**
-     * @brief Move assignment operator
-     * @param other The signal to move from
-     * @return Reference to this signal
+     * @brief Constructor with a name and the rate, starting with a full bucket
+     * @param name The name of the signal
+     * @param rate Sustained number of deliveries per second
+     * @param burst Maximum number of deliveries made at once after an idle period
      */
-    signal &operator=(signal &&other) noexcept = default;
-    
+    rate_limited_signal_base(const std::u8string &name, double rate, size_t burst = 1) : base_class{ name }
+    {
+        set_rate(rate, burst);
+
+        _credit = _interval * static_cast<int64_t>(bucket_size());
+    }
+
     /**
-     * @brief Virtual destructor
+     * @brief Constructor with a name, the rate and the timer wheel to schedule deliveries on, starting with a full bucket
+     * @param name The name of the signal
+     * @param rate Sustained number of deliveries per second
+     * @param burst Maximum number of deliveries made at once after an idle period
+     * @param wheel The timer wheel; it must outlive the signal
      */
-    virtual ~signal() override = default;
+    rate_limited_signal_base(const std::u8string &name, double rate, size_t burst, timer_wheel &wheel) : base_class{ name }, _timer_wheel{ &wheel }
+    {
+        set_rate(rate, burst);
+
+        _credit = _interval * static_cast<int64_t>(bucket_size());
+    }
 
     /**
-     * @brief Emits the signal with the given arguments
-     * 
-     * When a signal is emitted, all connected slots are invoked with the
-     * provided arguments. Slots are invoked in order of their priority.
-     * 
-     * @param args Arguments to pass to the slots
+     * @brief Destructor that optionally dispatches pending signals
      */
-    void emit(const Args &... args)
+    virtual ~rate_limited_signal_base() override
     {
-        if (!_enabled) return;
+        timer_wheel::timer_handle pending_timer;
 
-        std::scoped_lock lock_emit(_emit_lock);
+        {
+            std::scoped_lock lock(_emit_lock);
 
-        if (!_enabled) return;
+            _destroying = true;
+            pending_timer = std::move(_dispatch_timer);
+        }
 
+        _timer_wheel->cancel(pending_timer);
+
+        if (_dispatch_all_on_destroy)
         {
-            std::scoped_lock lock_con(_connect_lock);
+            std::scoped_lock lock(_emit_lock);
 
-            if (!std::empty(_pending_connections))
+            while (!std::empty(_signal_queue))
             {
-                std::move(std::begin(_pending_connections), std::end(_pending_connections), std::inserter(_slots, std::end(_slots)));
+                std::apply([this](Args&... a){ base_class::emit(std::move(a)...); }, _signal_queue.front());
 
-                _pending_connections.clear();
+                _signal_queue.pop_front();
             }
         }
+    }
 
-        if (!std::empty(_slots))
-        {
-            std::erase_if(_slots, [&args...](auto &callable)
-            {
-                if (callable.is_disconnected()) return true;
-
-                if (callable.is_enabled()) callable.invoke(args...);
+    /**
+     * @brief Emits the signal with the given arguments
+     * 
+     * Signal emissions are queued and delivered at the configured rate.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit(const Args &... args)
+    {
+        enqueue(args...);
+    }
 
-                return callable.is_disconnected();
-            });
-        }
+    /**
+     * @brief Emits the signal with arguments that are moved into the queue
+     * 
+     * Queued arguments are moved on to the slots when they are delivered, see signal::emit.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit(Args &&... args) requires (sizeof...(Args) > 0)
+    {
+        enqueue(std::move(args)...);
     }
 
     /**
@@ -735,543 +5521,565 @@ public:
     }
 
     /**
-     * @brief Connects a function to this signal
+     * @brief Function call operator to emit the signal with arguments that are moved into the queue
+     * @param args Arguments to pass to the slots
+     */
+    void operator() (Args &&... args) requires (sizeof...(Args) > 0)
+    {
+        emit(std::move(args)...);
+    }
+
+    /**
+     * @brief Sets the rate and the burst size
      * 
-     * @param callable Function to connect
-     * @param priority Priority of the connection
-     * @return A connection object that manages the connection's lifetime
+     * The tokens collected so far are kept, up to the new size of the bucket.
+     * 
+     * @param rate Sustained number of deliveries per second; values below one delivery per hour are raised to it
+     * @param burst Maximum number of deliveries made at once after an idle period, at least one
      */
-    [[nodiscard]] virtual connection connect(std::function<void(Args...)> &&callable, int64_t priority = 0)
+    void set_rate(double rate, size_t burst = 1)
     {
-        std::scoped_lock lock(_connect_lock);
-        auto end { std::end(_pending_connections) };
+        using namespace std::chrono;
+
+        const auto interval { nanoseconds { static_cast<int64_t>(std::ceil(1e9 / std::max(rate, 1.0 / 3600.0))) } };
 
-        _pending_connections.erase(std::remove_if(std::begin(_pending_connections), end, std::mem_fn(&slot<Args...>::is_disconnected)), end);
-        _pending_connections.emplace_back(std::forward<std::function<void(Args...)>>(callable), priority);
+        std::scoped_lock lock(_emit_lock);
+
+        const auto tokens { refill(clock_type::now()) };
 
-        return { this, _pending_connections.back() };
+        _interval = std::max(interval, nanoseconds { 1 });
+        _burst = std::max<size_t>(burst, 1);
+        _credit = _interval * static_cast<int64_t>(std::min(tokens, bucket_size()));
     }
 
     /**
-     * @brief Operator += to connect a function to this signal
-     * @param callable Function to connect
-     * @return A connection object that manages the connection's lifetime
+     * @brief Gets the sustained rate
+     * @return Number of deliveries per second
      */
-    [[nodiscard]] virtual connection operator += (std::function<void(Args...)> &&callable)
+    double get_rate() const
     {
-        return connect(std::forward<std::function<void(Args...)>>(callable));
+        std::scoped_lock lock(_emit_lock);
+
+        return 1e9 / static_cast<double>(_interval.count());
     }
 
     /**
-     * @brief Connects a member function to this signal
-     * 
-     * @param instance The object instance
-     * @param member_function Member function to connect
-     * @param priority Priority of the connection (lower value means higher priority)
-     * @return A connection object that manages the connection's lifetime
+     * @brief Gets the burst size
+     * @return Maximum number of deliveries made at once
      */
-    template<typename T>
-    [[nodiscard]] connection connect(T *instance, void (T::*member_function)(Args...), int64_t priority = 0)
+    size_t get_burst() const
     {
-        return connect([instance, member_function](Args... args) { (instance->*member_function)(args...); }, priority);
+        std::scoped_lock lock(_emit_lock);
+
+        return _burst;
     }
 
     /**
-     * @brief Disconnects all slots from this signal
+     * @brief Sets the maximum number of emissions delivered per wakeup
+     * @param max_batch Maximum number of deliveries, zero to deliver as many as there are tokens
      */
-    virtual void clear()
+    void set_max_batch(size_t max_batch) noexcept
     {
-        std::scoped_lock lock(_connect_lock, _emit_lock);
+        _max_batch = max_batch;
+    }
 
-        _pending_connections.clear();
-        _slots.clear();
+    /**
+     * @brief Gets the maximum number of emissions delivered per wakeup
+     * @return Maximum number of deliveries, zero if only limited by the tokens
+     */
+    size_t get_max_batch() const noexcept
+    {
+        return _max_batch;
     }
 
     /**
-     * @brief Gets the number of slots connected to this signal
-     * @return Number of connected slots
+     * @brief Sets whether all pending signals should be dispatched on destroy
+     * @param do_dispatch true to dispatch all pending signals, false otherwise
      */
-    virtual size_t size() const override
+    void set_dispatch_all_on_destroy(bool do_dispatch) noexcept
     {
-        std::scoped_lock lock(_emit_lock);
+        _dispatch_all_on_destroy = do_dispatch;
+    }
 
-        return std::size(_slots);
+    /**
+     * @brief Checks if all pending signals will be dispatched on destroy
+     * @return true if all pending signals will be dispatched, false otherwise
+     */
+    bool get_dispatch_all_on_destroy() const noexcept
+    {
+        return _dispatch_all_on_destroy;
     }
 
     /**
-     * @brief Sets the name of this signal
-     * @param name The new name
+     * @brief Gets the size of the signal queue
+     * @return Number of queued signal emissions
      */
-    void name(const std::u8string &name)
+    uint64_t get_queue_size() const
     {
-        std::unique_lock<std::shared_mutex> lock { _name_lock };
+        std::scoped_lock lock(_emit_lock);
 
-        _name = name;
+        return std::size(_signal_queue);
     }
 
     /**
-     * @brief Gets the name of this signal
-     * @return The signal's name
+     * @brief Bounds the signal queue
+     * @param capacity Maximum number of queued emissions, zero for unbounded
+     * @param policy The policy applied when the queue is full
      */
-    virtual std::u8string_view name() const override
+    void set_capacity(size_t capacity, overflow_policy policy = overflow_policy::drop_oldest)
     {
-        std::shared_lock<std::shared_mutex> lock { _name_lock };
+        std::scoped_lock lock(_emit_lock);
 
-        return _name;
+        _signal_queue.set_capacity(capacity, policy);
     }
 
     /**
-     * @brief Sets whether this signal is enabled
-     * @param enabled true to enable the signal, false to disable it
+     * @brief Gets the capacity of the signal queue
+     * @return Maximum number of queued emissions, zero if unbounded
      */
-    virtual void set_enabled(bool enabled) override
+    size_t get_capacity() const noexcept
     {
-        _enabled = enabled;
+        return _signal_queue.get_capacity();
     }
 
     /**
-     * @brief Checks if this signal is enabled
-     * @return true if the signal is enabled, false otherwise
+     * @brief Gets the overflow policy of the signal queue
+     * @return The policy applied when the queue is full
      */
-    virtual bool is_enabled() const override
+    overflow_policy get_overflow_policy() const noexcept
     {
-        return _enabled;
+        return _signal_queue.get_overflow_policy();
     }
 
     /**
-     * @brief Gets this signal's payload
-     * @return Reference to the signal's payload
+     * @brief Sets the functor computing the key used by the coalesce_by_key policy
+     * @param key Functor returning the key of an emission
      */
-    virtual std::any &payload() override
+    void set_coalesce_key(typename signal_queue<Args...>::key_functor &&key)
     {
-        return _payload;
+        std::scoped_lock lock(_emit_lock);
+
+        _signal_queue.set_coalesce_key(std::move(key));
     }
 
     /**
-     * @brief Enables or disables a slot
-     * @param slot The slot to enable/disable
-     * @param enabled true to enable the slot, false to disable it
+     * @brief Gets the number of emissions dropped because the queue was full
+     * @return Number of dropped emissions
      */
-    virtual void enable_slot(const slot_base &slot, bool enabled) override
+    uint64_t get_dropped_count() const noexcept
     {
-        enable_slot(slot._connection, enabled);
+        return _signal_queue.get_dropped_count();
     }
 
     /**
-     * @brief Enables or disables a slot by its connection
-     * @param s The connection to the slot
-     * @param enabled true to enable the slot, false to disable it
+     * @brief Gets the number of emissions merged into a queued one with the same key
+     * @return Number of coalesced emissions
      */
-    virtual void enable_slot(const paired_ptr<> &s, bool enabled) override
+    uint64_t get_coalesced_count() const noexcept
     {
-        auto send { std::end(_slots) };
-        auto sit { std::find(std::begin(_slots), send, s) };
-
-        if (sit != send) const_cast<slot<Args...>&>(*sit).set_enabled(enabled);
+        return _signal_queue.get_coalesced_count();
     }
 
-    /**
-     * @brief Checks if a slot is enabled
-     * @param slot The slot to check
-     * @return true if the slot is enabled, false otherwise
+protected:
+    signal_queue<Args...> _signal_queue {};
+    std::vector<std::tuple<Args...>> _batch {};
+    mutable std::mutex _emit_lock {};
+    std::chrono::nanoseconds _interval { 1ms }, _credit { 1ms };
+    size_t _burst { 1 };
+    clock_type::time_point _refilled { clock_type::now() };
+    std::atomic_size_t _max_batch { 0 };
+    timer_wheel *_timer_wheel { &timer_wheel::global() };
+    timer_wheel::timer_handle _dispatch_timer {};
+    bool _destroying { false };
+    std::atomic_bool _dispatch_all_on_destroy { true };
+    [[no_unique_address]] queue_gauges<is_instrumented_v<base_class>> _queue_gauges { this,
+        [this]{ return get_queue_size(); },
+        [this]{ return get_dropped_count(); },
+        [this]{ return get_coalesced_count(); } };
+
+    /**
+     * @brief Gets the number of tokens the bucket holds; the lock must be held
+     * 
+     * A wakeup may come up to a tick later than scheduled, so the bucket keeps the tokens
+     * of two ticks; otherwise rates above the resolution of the wheel would be capped
+     * at about one burst per tick.
+     * 
+     * @return The burst size, or the number of tokens collected over two ticks if that is more
      */
-    virtual bool is_slot_enabled(const slot_base &slot) const override
+    size_t bucket_size() const noexcept
     {
-        return is_slot_enabled(slot._connection);
+        const auto ticks { (2 * _timer_wheel->tick() + _interval - std::chrono::nanoseconds { 1 }) / _interval };
+
+        return std::max(_burst, static_cast<size_t>(ticks));
     }
 
     /**
-     * @brief Checks if a slot is enabled by its connection
-     * @param slot The connection to the slot
-     * @return true if the slot is enabled, false otherwise
+     * @brief Adds the tokens collected since the last refill; the lock must be held
+     * @param now The current time
+     * @return Number of whole tokens in the bucket
      */
-    virtual bool is_slot_enabled(const paired_ptr<> &slot) const override
+    size_t refill(clock_type::time_point now)
     {
-        if (auto s_ptr = find_slot(slot); s_ptr != nullptr) return s_ptr->is_enabled();
+        _credit = std::min(_credit + std::max(now - _refilled, clock_type::duration::zero()), _interval * static_cast<int64_t>(bucket_size()));
+        _refilled = now;
 
-        return false;
+        return static_cast<size_t>(_credit / _interval);
     }
 
     /**
-     * @brief Gets the priority of a connection
-     * @param con The connection to check
-     * @return The priority of the connection
+     * @brief Queues an emission and schedules its delivery
+     * @param args Arguments to pass to the slots
      */
-    virtual int64_t get_connection_priority(const paired_ptr<>& con) const override
+    template<typename... T>
+    void enqueue(T &&... args)
     {
-        if (auto s_ptr = find_slot(con); s_ptr != nullptr) return s_ptr->get_priority();
+        std::unique_lock lock(_emit_lock);
 
-        return {};
+        if (!_signal_queue.push(lock, std::forward<T>(args)...)) return;
+
+        if (!_dispatch_timer) _dispatch_timer = _timer_wheel->schedule(0ms, [this]{ dispatch_next(); });
     }
 
     /**
-     * @brief Sets the priority of a connection
-     * @param con The connection to modify
-     * @param priority The new priority
-     * @return true if the priority was set successfully, false otherwise
+     * @brief Timer callback that delivers as many queued emissions as there are tokens
+     * 
+     * The emissions are taken out of the queue and delivered without holding the lock,
+     * so emitting threads are not blocked by the slots. The timer handle stays set until
+     * the delivery is done, which keeps other deliveries from being scheduled meanwhile.
+     * Afterwards the next delivery is scheduled for when the next token is due.
      */
-    virtual bool set_connection_priority(const paired_ptr<>& con, int64_t priority) override
+    void dispatch_next()
     {
-        if (auto s_ptr = find_slot(con); s_ptr != nullptr)
         {
-            const_cast<slot_type*>(s_ptr)->set_priority(priority);
+            std::scoped_lock lock(_emit_lock);
 
-            return true;
+            if (_destroying) return;
+
+            const auto max_batch { _max_batch.load() };
+            auto count { std::min(refill(clock_type::now()), std::size(_signal_queue)) };
+
+            if (max_batch > 0) count = std::min(count, max_batch);
+
+            _credit -= _interval * static_cast<int64_t>(count);
+
+            for (; count > 0; --count)
+            {
+                _batch.push_back(std::move(_signal_queue.front()));
+                _signal_queue.pop_front();
+            }
         }
 
-        return false;
-    }
+        for (auto &&args : _batch) std::apply([this](Args&... a){ base_class::emit(std::move(a)...); }, args);
 
-protected:
-    std::u8string _name {};
-    std::vector<slot<Args...>> _pending_connections {};
-    slot_container _slots {};
-    mutable std::mutex _connect_lock {}, _emit_lock {};
-    mutable std::shared_mutex _name_lock {};
-    mutable std::atomic_bool _enabled { true };
-    std::any _payload;
+        _batch.clear();
 
-    /**
-     * @brief Finds a slot by its connection
-     * @param con The connection to find
-     * @return Pointer to the slot if found, nullptr otherwise
-     */
-    const slot_type* find_slot(const paired_ptr<>& con) const
-    {
-        auto send{ std::cend(_slots) };
-        auto sit{ std::find(std::cbegin(_slots), send, con) };
+        std::scoped_lock lock(_emit_lock);
 
-        if (sit != send) return &(*sit);
+        _dispatch_timer.reset();
 
-        auto psend{ std::cend(_pending_connections) };
-        auto psit{ std::find(std::cbegin(_pending_connections), psend, con) };
+        if (_destroying || std::empty(_signal_queue)) return;
 
-        if (psit != psend) return &(*psit);
+        const auto wait { _interval - std::min(_credit, _interval) };
 
-        return nullptr;
+        _dispatch_timer = _timer_wheel->schedule(wait, [this]{ dispatch_next(); });
     }
 };
 
 /**
- * @brief Extended signal class that passes itself as the first argument to slots
- * 
- * This is useful when slots need to know which signal triggered them.
- * 
- * @tparam Args Types of additional arguments the signal passes to slots
+ * @brief Type alias for a rate-limited signal
+ * @tparam Args Types of arguments the signal passes to slots
  */
-template<typename... Args>
-class signal_ex : public signal<signal_base*, Args...>
-{
-public:
-    using base_class = signal<signal_base*, Args...>;
-
-    /**
-     * @brief Default constructor
-     */
-    signal_ex() = default;
-    
-    /**
-     * @brief Constructor with a name
-     * @param name The name of the signal
-     */
-    signal_ex(const std::u8string &name) : base_class(name) {}
-    
-    /**
-     * @brief Move constructor
-     * @param other The signal to move from
-     */
-    signal_ex(signal_ex &&other) noexcept = default;
-    
-    /**
-     * @brief Move assignment operator
-     * @param other The signal to move from
-     * @return Reference to this signal
-     */
-    signal_ex &operator=(signal_ex &&other) noexcept = default;
-    
-    /**
-     * @brief Virtual destructor
-     */
-    virtual ~signal_ex() override = default;
+template<typename... Args> using rate_limited_signal = rate_limited_signal_base<signal, Args...>;
 
-    /**
-     * @brief Emits the signal with the given arguments
-     * 
-     * Unlike the base signal class, this automatically passes itself as the first argument.
-     * 
-     * @param args Arguments to pass to the slots
-     */
-    void emit(const Args&... args)
-    {
-        base_class::emit(this, args...);
-    }
+/**
+ * @brief Type alias for a rate-limited extended signal
+ * @tparam Args Types of arguments the signal passes to slots
+ */
+template<typename... Args> using rate_limited_signal_ex = rate_limited_signal_base<signal_ex, Args...>;
 
-    /**
-     * @brief Function call operator to emit the signal
-     * @param args Arguments to pass to the slots
-     */
-    void operator() (const Args&... args)
-    {
-        emit(args...);
-    }
-};
+/**
+ * @brief Type alias for a rate-limited signal that records metrics and publishes its queue gauges
+ * @tparam Args Types of arguments the signal passes to slots
+ */
+template<typename... Args> using instrumented_rate_limited_signal = rate_limited_signal_base<instrumented_signal, Args...>;
 
 /**
- * @brief Base class for bridged signals
- * 
- * A bridged signal queues emitted signals and allows controlling when they are
- * actually delivered to the slots.
- * 
- * @tparam signal_type The signal type to bridge
+ * @brief Base class for coalescing signals
+ *
+ * A coalescing signal delivers only the newest of the emissions made since its last
+ * delivery. Emitting fills a spare buffer and publishes it with one atomic exchange,
+ * taking the replaced buffer back as the next spare; a delivery takes the pending
+ * buffer out the same way. Each exchange hands a buffer over to exactly one thread, so
+ * producers never lock and a burst of emissions takes constant memory and is delivered
+ * once. Deliveries
+ * are scheduled on a timer wheel (the process-wide one by default), at most one per
+ * interval; slots are invoked on the wheel's dispatcher threads. To keep the newest
+ * value per key, use a coalescing_signal_set.
+ *
+ * @tparam signal_type The signal type to coalesce
  * @tparam Args Types of arguments the signal passes to slots
  */
 template<template <typename...> typename signal_type, std::copyable... Args>
 requires std::derived_from<signal_type<Args...>, signal_base>
-class bridged_signal_base : public signal_type<Args...>
+class coalescing_signal_base : public signal_type<Args...>
 {
 public:
     using base_class = signal_type<Args...>;
-    using bridged_signal_type = bridged_signal_base;
 
     /**
      * @brief Default constructor
      */
-    bridged_signal_base() = default;
-    
+    coalescing_signal_base() = default;
+
     /**
      * @brief Constructor with a name
      * @param name The name of the signal
      */
-    bridged_signal_base(const std::u8string &name) : base_class { name } {}
-    
+    coalescing_signal_base(const std::u8string &name) : base_class{ name } {}
+
     /**
-     * @brief Constructor with a name and emit functor
+     * @brief Constructor with a name and the interval between deliveries
      * @param name The name of the signal
-     * @param emit_functor Function to call when signal is emitted
-     */
-    bridged_signal_base(const std::u8string &name, const std::function<bool(bridged_signal_base*)>& emit_functor) : base_class { name }, _emit_functor { emit_functor } {}
-    
-    /**
-     * @brief Constructor with emit functor
-     * @param emit_functor Function to call when signal is emitted
+     * @param interval The minimal interval between deliveries
      */
-    bridged_signal_base(const std::function<bool(bridged_signal_base*)>& emit_functor) : bridged_signal_base { std::u8string {}, emit_functor } {}
-    
+    template<typename Duration>
+    coalescing_signal_base(const std::u8string &name, const Duration &interval) : base_class{ name }, _interval{ std::chrono::duration_cast<std::chrono::milliseconds>(interval) } {}
+
     /**
-     * @brief Constructor with a name and bridge enabled flag
+     * @brief Constructor with a name, the interval between deliveries and the timer wheel to schedule them on
      * @param name The name of the signal
-     * @param bridge_enabled Whether the bridge is enabled
-     */
-    bridged_signal_base(const std::u8string &name, bool bridge_enabled) : base_class { name }, _bridge_enabled { bridge_enabled } {}
-    
-    /**
-     * @brief Constructor with bridge enabled flag
-     * @param bridge_enabled Whether the bridge is enabled
-     */
-    bridged_signal_base(bool bridge_enabled) : bridged_signal_base { std::u8string {}, bridge_enabled } {}
-    
-    /**
-     * @brief Move constructor
-     * @param other The signal to move from
-     */
-    bridged_signal_base(bridged_signal_base &&other) noexcept = default;
-    
-    /**
-     * @brief Move assignment operator
-     * @param other The signal to move from
-     * @return Reference to this signal
+     * @param interval The minimal interval between deliveries
+     * @param wheel The timer wheel; it must outlive the signal
      */
-    bridged_signal_base &operator=(bridged_signal_base &&other) noexcept = default;
-    
+    template<typename Duration>
+    coalescing_signal_base(const std::u8string &name, const Duration &interval, timer_wheel &wheel) : base_class{ name }, _interval{ std::chrono::duration_cast<std::chrono::milliseconds>(interval) }, _timer_wheel{ &wheel } {}
+
+    coalescing_signal_base(const coalescing_signal_base &other) = delete;
+    coalescing_signal_base &operator=(const coalescing_signal_base &other) = delete;
+
     /**
-     * @brief Virtual destructor
+     * @brief Destructor that optionally delivers the pending emission
      */
-    virtual ~bridged_signal_base() override = default;
+    virtual ~coalescing_signal_base() override
+    {
+        timer_wheel::timer_handle pending_timer;
+
+        {
+            std::scoped_lock lock(_timer_lock);
+
+            _destroying = true;
+            pending_timer = std::move(_dispatch_timer);
+        }
+
+        _timer_wheel->cancel(pending_timer);
+
+        std::scoped_lock lock(_dispatch_lock);
+
+        if (_dispatch_all_on_destroy) deliver();
+
+        delete _pending.exchange(nullptr);
+        delete _spare.exchange(nullptr);
+    }
 
     /**
      * @brief Emits the signal with the given arguments
-     * 
-     * If bridging is enabled, the signal is queued instead of immediately delivered.
-     * 
+     *
+     * The arguments replace the pending emission, if any, and a delivery is scheduled
+     * unless one is scheduled already.
+     *
      * @param args Arguments to pass to the slots
      */
-    void emit(const Args&... args)
+    void emit(const Args &... args)
     {
         if (!base_class::_enabled) return;
 
-        if (_bridge_enabled)
-        {
-            {
-                std::scoped_lock lock(_queue_lock);
+        auto buffer { _spare.exchange(nullptr) };
 
-                _signal_queue.push_back(std::make_tuple(args...));
-            }
+        if (buffer) *buffer = std::tuple<Args...>(args...);
+        else buffer = new std::tuple<Args...>(args...);
 
-            if (!_emit_functor || !_emit_functor(this)) invoke_next();
+        if (auto replaced { _pending.exchange(buffer) })
+        {
+            ++_coalesced;
+
+            recycle(replaced);
         }
-        else base_class::emit(args...);
+
+        if (_scheduled.exchange(true)) return;
+
+        std::scoped_lock lock(_timer_lock);
+
+        if (!_destroying) _dispatch_timer = _timer_wheel->schedule(_interval.load(), [this]{ dispatch(); });
     }
 
     /**
      * @brief Function call operator to emit the signal
      * @param args Arguments to pass to the slots
      */
-    void operator() (const Args&... args)
+    void operator() (const Args &... args)
     {
         emit(args...);
     }
 
     /**
-     * @brief Emits the signal synchronously, bypassing bridging
-     * @param args Arguments to pass to the slots
+     * @brief Delivers the pending emission on the calling thread
+     * @return true if an emission was pending, false otherwise
      */
-    void emit_sync(const Args&... args)
+    bool flush()
     {
-        base_class::emit(args...);
+        std::scoped_lock lock(_dispatch_lock);
+
+        return deliver();
     }
 
     /**
-     * @brief Invokes the next queued signal emission
-     * @return true if there are more signals in the queue, false otherwise
+     * @brief Checks whether an emission is waiting for delivery
+     * @return true if an emission is pending, false otherwise
      */
-    virtual bool invoke_next()
+    bool has_pending() const noexcept
     {
-        if (std::empty(_signal_queue)) return false;
-
-        std::scoped_lock lock(_queue_lock);
-
-        if (std::empty(_signal_queue)) return false;
-
-        std::apply([this](const Args&... a){ base_class::emit(a...); }, _signal_queue.front());
-
-        _signal_queue.pop_front();
-
-        return !std::empty(_signal_queue);
+        return _pending.load() != nullptr;
     }
 
     /**
-     * @brief Invokes all queued signal emissions
+     * @brief Sets the minimal interval between deliveries
+     * @param interval The new interval
      */
-    virtual void invoke_all()
+    template<typename Duration>
+    void interval(const Duration &interval) noexcept
     {
-        if (std::empty(_signal_queue)) return;
-
-        std::scoped_lock lock(_queue_lock);
-
-        if (std::empty(_signal_queue)) return;
-
-        for (auto &&args : _signal_queue) std::apply([this](const Args&... a){ base_class::emit(a...); }, args);
-
-        _signal_queue.clear();
+        _interval.store(std::chrono::duration_cast<std::chrono::milliseconds>(interval));
     }
 
     /**
-     * @brief Invokes only the last queued signal emission and clears the queue
+     * @brief Gets the minimal interval between deliveries
+     * @return The interval in milliseconds
      */
-    virtual void invoke_last_and_clear()
+    std::chrono::milliseconds interval() const noexcept
     {
-        if (std::empty(_signal_queue)) return;
-
-        std::scoped_lock lock(_queue_lock);
-
-        if (std::empty(_signal_queue)) return;
-
-        std::apply([this](const Args&... a){ base_class::emit(a...); }, _signal_queue.back());
-
-        _signal_queue.clear();
+        return _interval.load();
     }
 
     /**
-     * @brief Sets the emit functor
-     * @param emit_functor Function to call when signal is emitted
+     * @brief Sets whether the pending emission should be delivered on destroy
+     * @param do_dispatch true to deliver the pending emission, false otherwise
      */
-    void set_emit_functor(const std::function<bool(bridged_signal_base*)>& emit_functor)
+    void set_dispatch_all_on_destroy(bool do_dispatch) noexcept
     {
-        _emit_functor = emit_functor;
+        _dispatch_all_on_destroy = do_dispatch;
     }
 
     /**
-     * @brief Gets the emit functor
-     * @return The emit functor
+     * @brief Checks if the pending emission will be delivered on destroy
+     * @return true if the pending emission will be delivered, false otherwise
      */
-    const std::function<bool(bridged_signal_base*)> &get_emit_functor() const noexcept
+    bool get_dispatch_all_on_destroy() const noexcept
     {
-        return _emit_functor;
+        return _dispatch_all_on_destroy;
     }
 
     /**
-     * @brief Gets the size of the signal queue
-     * @return Number of queued signal emissions
+     * @brief Gets the number of emissions replaced by a newer one before their delivery
+     * @return Number of coalesced emissions
      */
-    uint64_t get_queue_size() const
+    uint64_t get_coalesced_count() const noexcept
     {
-        std::scoped_lock lock(_queue_lock);
-
-        return std::size(_signal_queue);
+        return _coalesced;
     }
 
+protected:
+    std::atomic<std::tuple<Args...>*> _pending { nullptr }, _spare { nullptr };
+    std::mutex _dispatch_lock {}, _timer_lock {};
+    std::atomic_bool _scheduled { false }, _dispatch_all_on_destroy { true };
+    std::atomic<std::chrono::milliseconds> _interval { 0ms };
+    std::atomic_uint64_t _coalesced { 0 };
+    timer_wheel *_timer_wheel { &timer_wheel::global() };
+    timer_wheel::timer_handle _dispatch_timer {};
+    bool _destroying { false };
+
     /**
-     * @brief Sets whether bridging is enabled
-     * @param enabled true to enable bridging, false to disable it
+     * @brief Swaps the pending emission out and delivers it; the dispatch lock must be held
+     * @return true if an emission was pending, false otherwise
      */
-    void set_bridge_enabled(bool enabled) noexcept
+    bool deliver()
     {
-        _bridge_enabled.store(enabled);
+        std::unique_ptr<std::tuple<Args...>> buffer { _pending.exchange(nullptr) };
+
+        if (!buffer) return false;
+
+        std::apply([this](const Args&... a){ base_class::emit(a...); }, *buffer);
+
+        recycle(buffer.release());
+
+        return true;
     }
 
     /**
-     * @brief Checks if bridging is enabled
-     * @return true if bridging is enabled, false otherwise
+     * @brief Keeps a buffer as the spare one, freeing the spare it replaces
      */
-    bool get_bridge_enabled() const noexcept
+    void recycle(std::tuple<Args...> *buffer) noexcept
     {
-        return _bridge_enabled;
+        delete _spare.exchange(buffer);
     }
 
     /**
-     * @brief Clears the signal queue
+     * @brief Timer callback that delivers the pending emission
+     *
+     * The scheduled flag is cleared before the delivery, so emissions made meanwhile,
+     * including those made by the slots, schedule the next delivery.
      */
-    void clear_queue()
+    void dispatch()
     {
-        if (std::empty(_signal_queue)) return;
+        std::scoped_lock lock(_dispatch_lock);
 
-        std::scoped_lock lock(_queue_lock);
+        {
+            std::scoped_lock timer_lock(_timer_lock);
 
-        if (std::empty(_signal_queue)) return;
+            _dispatch_timer.reset();
 
-        _signal_queue.clear();
-    }
+            if (_destroying) return;
 
-protected:
-    std::atomic_bool _bridge_enabled { true };
-    std::mutex _queue_lock {};
-    std::deque<std::tuple<Args...>> _signal_queue {};
-    std::function<bool(bridged_signal_base*)> _emit_functor { nullptr };
+            _scheduled = false;
+        }
+
+        deliver();
+    }
 };
 
 /**
- * @brief Type alias for a bridged signal
+ * @brief Type alias for a coalescing signal
  * @tparam Args Types of arguments the signal passes to slots
  */
-template<typename... Args> using bridged_signal = bridged_signal_base<signal, Args...>;
+template<typename... Args> using coalescing_signal = coalescing_signal_base<signal, Args...>;
 
 /**
- * @brief Type alias for a bridged extended signal
+ * @brief Type alias for a coalescing extended signal
  * @tparam Args Types of arguments the signal passes to slots
  */
-template<typename... Args> using bridged_signal_ex = bridged_signal_base<signal_ex, Args...>;
+template<typename... Args> using coalescing_signal_ex = coalescing_signal_base<signal_ex, Args...>;
 
 /**
- * @brief Base class for throttled signals
+ * @brief Default scope for queued signals
+ */
+struct queued_signal_default_scope {};
+
+/**
+ * @brief Base class for queued signals
  * 
- * A throttled signal limits the rate at which signal emissions are delivered to slots.
+ * A queued signal queues emissions in a static queue, shared by all signals of
+ * the same scope. The queue is a lock-free multi-producer single-consumer list whose
+ * nodes are carved from preallocated segments and recycled, so emitting does not
+ * allocate in the steady state and takes a short lock on the shared free list only
+ * once per batch of nodes; the dispatcher thread drains the queue in batches and
+ * runs the slots without holding any lock the producers take.
  * 
- * @tparam signal_type The signal type to throttle
+ * @tparam scope The scope for grouping queued signals
+ * @tparam signal_type The signal type to queue
  * @tparam Args Types of arguments the signal passes to slots
  */
-template<template <typename...> typename signal_type, std::copyable... Args>
+template<typename scope, template <typename...> typename signal_type, std::movable... Args>
 requires std::derived_from<signal_type<Args...>, signal_base>
-class throttled_signal_base : public signal_type<Args...>
+class queued_signal_base : public signal_type<Args...>
 {
 public:
     using base_class = signal_type<Args...>;
@@ -1279,72 +6087,121 @@ public:
     /**
      * @brief Default constructor
      */
-    throttled_signal_base() = default;
+    queued_signal_base() = default;
     
     /**
-     * @brief Constructor with a name and throttle duration
+     * @brief Constructor with a name and delay
      * @param name The name of the signal
-     * @param throttle_ms The throttling duration
+     * @param delay_ms The delay between emissions
      */
     template<typename Duration>
-    throttled_signal_base(const std::u8string &name, const Duration &throttle_ms = throttled_signal_base::_default_throttle_ms) : base_class{ name }, _throttle_ms{ std::chrono::duration_cast<std::chrono::milliseconds>(throttle_ms) } {}
+    queued_signal_base(const std::u8string& name, const Duration& delay_ms = 0ms) : base_class{ name } { _delay_ms = delay_ms; }
     
     /**
      * @brief Constructor with a name
      * @param name The name of the signal
      */
-    throttled_signal_base(const std::u8string &name) : base_class{ name } {}
+    queued_signal_base(const std::u8string &name) : base_class{ name } {}
     
     /**
      * @brief Move constructor
      * @param other The signal to move from
      */
-    throttled_signal_base(throttled_signal_base &&other) noexcept = default;
+    queued_signal_base(queued_signal_base &&other) noexcept = default;
     
     /**
      * @brief Move assignment operator
      * @param other The signal to move from
      * @return Reference to this signal
      */
-    throttled_signal_base &operator=(throttled_signal_base &&other) noexcept = default;
+    queued_signal_base &operator=(queued_signal_base &&other) noexcept = default;
+    
+    queued_signal_base(const queued_signal_base &other) = delete;
+    queued_signal_base &operator=(const queued_signal_base &other) = delete;
 
     /**
      * @brief Destructor that optionally dispatches pending signals
+     * 
+     * The emissions of this signal are taken out of their nodes, which stay in the queue
+     * with no signal and are skipped by the dispatcher thread; pending emissions of other
+     * signals are left untouched.
      */
-    virtual ~throttled_signal_base() override
+    virtual ~queued_signal_base() override
     {
-        if (_dispatch_all_on_destroy)
+        std::unique_lock lock(_dispatcher->dispatch_lock, std::defer_lock);
+
+        if (!_dispatching) lock.lock();
+
+        auto was_dispatching { std::exchange(_dispatching, true) };
+        std::vector<std::tuple<Args...>> own_items {};
+        auto take_own { [this, &own_items](queue_node *node)
         {
-            std::scoped_lock lock(_emit_lock);
+            if (node->item && std::get<0>(*node->item) == this)
+            {
+                own_items.push_back(std::move(std::get<1>(*node->item)));
 
-            while (!std::empty(_signal_queue))
+                std::get<0>(*node->item) = nullptr;
+            }
+        } };
+
+        auto &state { *_dispatcher };
+        auto pending_position { std::min(state.batch_position + 1, state.batch_size) };
+
+        for (auto node : std::span { state.batch }.subspan(pending_position, state.batch_size - pending_position)) take_own(node);
+
+        {
+            std::scoped_lock queue_lock(state.queue_lock);
+
+            // a producer links its node only after swapping the tail, so the nodes up to the
+            // tail seen here may not all be reachable yet
+            if (state.head != &state.stub) take_own(state.head);
+
+            for (auto node { state.head }, last { state.tail.load() }; node != last;)
             {
-                std::apply([this](const Args&... a){ base_class::emit(a...); }, _signal_queue.front());
+                auto next { node->next.load() };
 
-                _signal_queue.pop_front();
+                if (!next)
+                {
+                    std::this_thread::yield();
+
+                    continue;
+                }
+
+                if ((node = next) != &state.stub) take_own(node);
             }
         }
+
+        if (_dispatch_all_on_destroy)
+            for (auto &&args : own_items) std::apply([this](Args&... a){ base_class::emit(std::move(a)...); }, args);
+
+        _dispatching = was_dispatching;
     }
 
     /**
      * @brief Emits the signal with the given arguments
      * 
-     * Signal emissions are queued and delivered at a controlled rate.
+     * Signal emissions are queued in a shared queue.
+	 * Parameters are copied and passed as a tuple to the queue.
+	 * Since parameters are copied, they should be copiable and should not be const, reference or rvalue.
      * 
      * @param args Arguments to pass to the slots
      */
     void emit(const Args &... args)
     {
-        std::scoped_lock lock(_emit_lock);
-
-        _signal_queue.push_back(std::make_tuple(args...));
-
-        if (!_thread_running.exchange(true))
-        {
-            if (_dispatcher_thread.joinable()) _dispatcher_thread.join();
+        enqueue(args...);
+    }
 
-            _dispatcher_thread = std::jthread([this](std::stop_token cancelled){ queue_dispatcher(std::move(cancelled)); });
-        }
+    /**
+     * @brief Emits the signal with arguments that are moved into the queue
+     * 
+     * Move-only arguments are supported. Queued arguments are moved on to the slots when
+     * they are delivered, see signal::emit.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit(Args &&... args) requires (sizeof...(Args) > 0)
+    {
+        enqueue(std::move(args)...);
     }
 
     /**
@@ -1357,22 +6214,49 @@ public:
     }
 
     /**
-     * @brief Sets the throttling duration
-     * @param duration The new throttling duration
+     * @brief Function call operator to emit the signal with arguments that are moved into the queue
+     * @param args Arguments to pass to the slots
+     */
+    void operator() (Args &&... args) requires (sizeof...(Args) > 0)
+    {
+        emit(std::move(args)...);
+    }
+
+    /**
+     * @brief Sets the delay between emissions
+     * @param duration The new delay
      */
     template<typename Duration>
-    void throttle_ms(const Duration &duration) noexcept
+    static void delay_ms(const Duration &duration) noexcept
     {
-        _throttle_ms.store(std::chrono::duration_cast<std::chrono::milliseconds>(duration));
+        _delay_ms.store(std::chrono::duration_cast<std::chrono::milliseconds>(duration));
     }
 
     /**
-     * @brief Gets the throttling duration
-     * @return The throttling duration in milliseconds
+     * @brief Gets the delay between emissions
+     * @return The delay in milliseconds
      */
-    std::chrono::milliseconds throttle_ms() const noexcept
+    static std::chrono::milliseconds delay_ms() noexcept
     {
-        return _throttle_ms.load();
+        return _delay_ms.load();
+    }
+
+    /**
+     * @brief Sets whether to use delay between emissions
+     * @param use true to use delay, false otherwise
+     */
+    static void use_delay(bool use) noexcept
+    {
+        _use_delay = use;
+    }
+
+    /**
+     * @brief Checks if delay is used between emissions
+     * @return true if delay is used, false otherwise
+     */
+    static bool use_delay() noexcept
+    {
+        return _use_delay;
     }
 
     /**
@@ -1393,235 +6277,485 @@ public:
         return _dispatch_all_on_destroy;
     }
 
-protected:
-    static inline std::chrono::milliseconds _default_throttle_ms { 10ms };
-    std::deque<std::tuple<Args...>> _signal_queue {};
-    std::mutex _emit_lock {};
-    std::atomic<std::chrono::milliseconds> _throttle_ms { _default_throttle_ms };
-    std::jthread _dispatcher_thread {};
-    std::atomic_bool _thread_running { false }, _dispatch_all_on_destroy { true };
-
     /**
-     * @brief Thread function that dispatches queued signals
-     * @param cancelled Stop token for thread cancellation
+     * @brief Bounds the queue shared by all signals of the scope
+     * 
+     * The bound is approximate under concurrent emission. The queue is kept lock-free
+     * while it is not full; dropping the oldest emission or coalescing takes the short
+     * lock the dispatcher holds while taking a batch off the queue, never while running
+     * slots. Emissions made by slots dispatched from this queue never block.
+     * 
+     * @param capacity Maximum number of queued emissions, zero for unbounded
+     * @param policy The policy applied when the queue is full
      */
-    void queue_dispatcher(std::stop_token cancelled)
+    static void set_capacity(size_t capacity, overflow_policy policy = overflow_policy::drop_oldest)
     {
-        while (!cancelled.stop_requested())
-        {
-            {
-                std::scoped_lock lock(_emit_lock);
-
-                if (cancelled.stop_requested() || std::empty(_signal_queue)) break;
+        auto &state { dispatcher() };
 
-                std::apply([this](const Args&... a){ base_class::emit(a...); }, _signal_queue.front());
+        state.policy = policy;
+        state.capacity = capacity;
 
-                _signal_queue.pop_front();
+        state.size.notify_all();
+    }
 
-                if (std::empty(_signal_queue)) break;
-            }
+    /**
+     * @brief Gets the capacity of the queue shared by all signals of the scope
+     * @return Maximum number of queued emissions, zero if unbounded
+     */
+    static size_t get_capacity() noexcept
+    {
+        return dispatcher().capacity;
+    }
 
-            std::this_thread::sleep_for(_throttle_ms.load());
-        }
+    /**
+     * @brief Gets the overflow policy of the queue shared by all signals of the scope
+     * @return The policy applied when the queue is full
+     */
+    static overflow_policy get_overflow_policy() noexcept
+    {
+        return dispatcher().policy;
+    }
 
-        _thread_running = false;
+    /**
+     * @brief Gets the number of emissions dropped because the queue was full
+     * @return Number of dropped emissions in the scope
+     */
+    static uint64_t get_dropped_count() noexcept
+    {
+        return dispatcher().dropped;
     }
-};
 
-/**
- * @brief Type alias for a throttled signal
- * @tparam Args Types of arguments the signal passes to slots
- */
-template<typename... Args> using throttled_signal = throttled_signal_base<signal, Args...>;
+    /**
+     * @brief Gets the number of emissions merged into a queued one with the same key
+     * @return Number of coalesced emissions in the scope
+     */
+    static uint64_t get_coalesced_count() noexcept
+    {
+        return dispatcher().coalesced;
+    }
 
-/**
- * @brief Type alias for a throttled extended signal
- * @tparam Args Types of arguments the signal passes to slots
- */
-template<typename... Args> using throttled_signal_ex = throttled_signal_base<signal_ex, Args...>;
+    /**
+     * @brief Sets the functor computing the key used by the coalesce_by_key policy
+     * 
+     * Only queued emissions of this signal are coalesced. Without a key functor the
+     * newest queued emission of this signal is replaced.
+     * 
+     * @param key Functor returning the key of an emission
+     */
+    void set_coalesce_key(typename signal_queue<Args...>::key_functor &&key)
+    {
+        std::scoped_lock lock(_dispatcher->queue_lock);
 
-/**
- * @brief Default scope for queued signals
- */
-struct queued_signal_default_scope {};
+        _coalesce_key = std::move(key);
+    }
 
-/**
- * @brief Base class for queued signals
- * 
- * A queued signal queues emissions in a static queue, shared by all signals of
- * the same scope.
- * 
- * @tparam scope The scope for grouping queued signals
- * @tparam signal_type The signal type to queue
- * @tparam Args Types of arguments the signal passes to slots
- */
-template<typename scope, template <typename...> typename signal_type, std::copyable... Args>
-requires std::derived_from<signal_type<Args...>, signal_base>
-class queued_signal_base : public signal_type<Args...>
-{
-public:
-    using base_class = signal_type<Args...>;
+protected:
+    using queued_item = std::tuple<queued_signal_base*, std::tuple<Args...>>;
 
     /**
-     * @brief Default constructor
+     * @brief A node of the emission queue
      */
-    queued_signal_base() = default;
-    
+    struct queue_node
+    {
+        std::atomic<queue_node*> next { nullptr };
+        std::optional<queued_item> item {};
+    };
+
     /**
-     * @brief Constructor with a name and delay
-     * @param name The name of the signal
-     * @param delay_ms The delay between emissions
+     * @brief A preallocated block of queue nodes
      */
-    template<typename Duration>
-    queued_signal_base(const std::u8string& name, const Duration& delay_ms = 0ms) : base_class{ name } { _delay_ms = delay_ms; }
-    
+    struct queue_segment
+    {
+        std::array<queue_node, 256> nodes {};
+        queue_segment *next { nullptr };
+    };
+
     /**
-     * @brief Constructor with a name
-     * @param name The name of the signal
+     * @brief The emission queue and the dispatcher thread shared by all signals of the scope
      */
-    queued_signal_base(const std::u8string &name) : base_class{ name } {}
-    
+    struct dispatcher_state
+    {
+        queue_node stub {};
+        alignas(64) std::atomic<queue_node*> tail { &stub };
+        alignas(64) queue_node *head { &stub };
+        queue_node *free_nodes { nullptr };
+        std::atomic<queue_segment*> segments { nullptr };
+        std::atomic_bool waiting { false };
+        std::atomic_uint32_t wakeups { 0 }, blocked_producers { 0 };
+        std::atomic_size_t size { 0 }, capacity { 0 };
+        std::atomic<overflow_policy> policy { overflow_policy::block };
+        std::atomic_uint64_t dropped { 0 }, coalesced { 0 };
+        std::mutex dispatch_lock {}, queue_lock {}, free_lock {};
+        std::array<queue_node*, 64> batch {};
+        size_t batch_position { 0 }, batch_size { 0 };
+        std::once_flag started {};
+        std::jthread thread {};
+
+        ~dispatcher_state()
+        {
+            if (thread.joinable())
+            {
+                thread.request_stop();
+                wakeups.fetch_add(1);
+                wakeups.notify_all();
+                thread.join();
+            }
+
+            for (auto segment { segments.load() }; segment;) delete std::exchange(segment, segment->next);
+        }
+    };
+
     /**
-     * @brief Move constructor
-     * @param other The signal to move from
+     * @brief Free nodes taken from the shared free list by the current thread, at most node_batch_size of them
      */
-    queued_signal_base(queued_signal_base &&other) noexcept = default;
-    
+    struct node_cache
+    {
+        dispatcher_state *state { nullptr };
+        queue_node *nodes { nullptr };
+
+        ~node_cache()
+        {
+            if (!nodes) return;
+
+            auto last { nodes };
+
+            while (auto next { last->next.load(std::memory_order_relaxed) }) last = next;
+
+            release_nodes(*state, nodes, last);
+        }
+    };
+
+    static constexpr size_t node_batch_size { 32 };
+
+    static inline std::atomic<std::chrono::milliseconds> _delay_ms { 0ms };
+    static inline std::atomic_bool _use_delay { false }, _dispatch_all_on_destroy { true };
+    static inline thread_local node_cache _node_cache {};
+    static inline thread_local bool _dispatching { false };
+    dispatcher_state *_dispatcher { &dispatcher() };
+    typename signal_queue<Args...>::key_functor _coalesce_key {};
+    [[no_unique_address]] queue_gauges<is_instrumented_v<base_class>> _queue_gauges { this,
+        []{ return static_cast<uint64_t>(dispatcher().size.load()); },
+        []{ return get_dropped_count(); },
+        []{ return get_coalesced_count(); } };
+
     /**
-     * @brief Move assignment operator
-     * @param other The signal to move from
-     * @return Reference to this signal
-     */
-    queued_signal_base &operator=(queued_signal_base &&other) noexcept = default;
-    
-    queued_signal_base(const queued_signal_base &other) = delete;
-    queued_signal_base &operator=(const queued_signal_base &other) = delete;
+     * @brief Gets the dispatcher state of the scope
+     * @return Reference to the dispatcher state
+     */
+    static dispatcher_state &dispatcher()
+    {
+        static dispatcher_state state {};
+
+        return state;
+    }
 
     /**
-     * @brief Destructor that optionally dispatches pending signals
+     * @brief Takes a free node, refilling the thread's cache from the shared free list or a new segment
+     * 
+     * The cache takes a bounded batch of nodes, so producers share the free nodes and the
+     * node memory stays bounded by the emissions in flight rather than by the number of
+     * producing threads.
      */
-    virtual ~queued_signal_base() override
+    static queue_node *acquire_node(dispatcher_state &state)
     {
-        std::scoped_lock lock_(_destruct_lock);
+        auto &cache { _node_cache };
 
-        if (_dispatch_all_on_destroy)
+        cache.state = &state;
+
+        if (!cache.nodes) cache.nodes = take_nodes(state);
+
+        return std::exchange(cache.nodes, cache.nodes->next.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Takes up to node_batch_size nodes from the shared free list, adding a new segment to it if it is empty
+     * @return A null-terminated chain of free nodes
+     */
+    static queue_node *take_nodes(dispatcher_state &state)
+    {
         {
-            std::scoped_lock lock(_emit_lock);
+            std::scoped_lock lock(state.free_lock);
 
-            if (!std::empty(_signal_queue))
-            {
-                auto end{ std::end(_signal_queue) };
+            if (state.free_nodes) return cut_batch(state.free_nodes);
+        }
 
-                _signal_queue.erase(std::remove_if(std::begin(_signal_queue), end, [this](auto &value)
-                {
-                    auto &[this_, args] = value;
+        auto segment { new queue_segment {} };
+        auto &nodes { segment->nodes };
 
-                    if (this_ == this)
-                    {
-                        std::apply([this](const Args&... a){ base_class::emit(a...); }, args);
+        for (size_t i = 1; i < std::size(nodes); ++i) nodes[i - 1].next.store(&nodes[i], std::memory_order_relaxed);
 
-                        return true;
-                    }
+        segment->next = state.segments.load(std::memory_order_relaxed);
 
-                    return false;
-                }), end);
-            }
-        }
+        while (!state.segments.compare_exchange_weak(segment->next, segment, std::memory_order_release, std::memory_order_relaxed));
+
+        queue_node *rest { &nodes[0] };
+        auto batch { cut_batch(rest) };
+
+        release_nodes(state, rest, &nodes.back());
+
+        return batch;
     }
 
     /**
-     * @brief Emits the signal with the given arguments
-     * 
-     * Signal emissions are queued in a shared queue.
-	 * Parameters are copied and passed as a tuple to the queue.
-	 * Since parameters are copied, they should be copiable and should not be const, reference or rvalue.
-     * 
-     * @param args Arguments to pass to the slots
+     * @brief Cuts up to node_batch_size nodes from the front of a chain
+     * @param chain The chain, which is left starting after the cut nodes
+     * @return The cut nodes as a null-terminated chain
      */
-    void emit(const Args &... args)
+    static queue_node *cut_batch(queue_node *&chain) noexcept
     {
-        std::scoped_lock lock(_emit_lock);
-
-        _signal_queue.push_back({ this, std::make_tuple(args...) });
+        auto first { chain }, last { chain };
 
-        if (!_thread_running.exchange(true))
+        for (size_t count = 1; count < node_batch_size; ++count)
         {
-            if (_dispatcher_thread.joinable()) _dispatcher_thread.join();
+            auto next { last->next.load(std::memory_order_relaxed) };
 
-            _dispatcher_thread = std::jthread(&queue_dispatcher);
+            if (!next) break;
+
+            last = next;
         }
+
+        chain = last->next.load(std::memory_order_relaxed);
+        last->next.store(nullptr, std::memory_order_relaxed);
+
+        return first;
     }
 
     /**
-     * @brief Function call operator to emit the signal
-     * @param args Arguments to pass to the slots
+     * @brief Returns a chain of nodes to the shared free list
      */
-    void operator() (const Args &... args)
+    static void release_nodes(dispatcher_state &state, queue_node *first, queue_node *last)
     {
-        emit(args...);
+        if (!first) return;
+
+        std::scoped_lock lock(state.free_lock);
+
+        last->next.store(state.free_nodes, std::memory_order_relaxed);
+        state.free_nodes = first;
     }
 
     /**
-     * @brief Sets the delay between emissions
-     * @param duration The new delay
+     * @brief Destroys the item of a consumed node and appends the node to a chain to be released
      */
-    template<typename Duration>
-    static void delay_ms(const Duration &duration) noexcept
+    static void recycle_node(queue_node *node, queue_node *&first, queue_node *&last)
     {
-        _delay_ms.store(std::chrono::duration_cast<std::chrono::milliseconds>(duration));
+        node->item.reset();
+        node->next.store(nullptr, std::memory_order_relaxed);
+
+        if (last) last->next.store(node, std::memory_order_relaxed);
+        else first = node;
+
+        last = node;
     }
 
     /**
-     * @brief Gets the delay between emissions
-     * @return The delay in milliseconds
+     * @brief Takes the oldest node off the queue; must be called with the queue lock held
+     * @return The node, or nullptr if the queue is empty or its oldest item is still being pushed
      */
-    static std::chrono::milliseconds delay_ms() noexcept
+    static queue_node *pop_node(dispatcher_state &state)
     {
-        return _delay_ms.load();
+        auto head { state.head };
+        auto next { head->next.load() };
+
+        if (head == &state.stub)
+        {
+            if (!next) return nullptr;
+
+            state.head = head = next;
+            next = next->next.load();
+        }
+
+        if (next)
+        {
+            state.head = next;
+
+            return head;
+        }
+
+        if (head != state.tail.load()) return nullptr;
+
+        state.stub.next.store(nullptr, std::memory_order_relaxed);
+        state.tail.exchange(&state.stub)->next.store(&state.stub);
+
+        if ((next = head->next.load()))
+        {
+            state.head = next;
+
+            return head;
+        }
+
+        return nullptr;
     }
 
     /**
-     * @brief Sets whether to use delay between emissions
-     * @param use true to use delay, false otherwise
+     * @brief Dispatches up to a batch of queued emissions
+     * @return The number of emissions dispatched
      */
-    static void use_delay(bool use) noexcept
+    static size_t dispatch_batch(dispatcher_state &state, size_t batch_size)
     {
-        _use_delay = use;
+        std::scoped_lock lock(state.dispatch_lock);
+
+        {
+            std::scoped_lock queue_lock(state.queue_lock);
+
+            auto &size { state.batch_size };
+
+            for (size = 0; size < std::min(batch_size, std::size(state.batch)); ++size) if (!(state.batch[size] = pop_node(state))) break;
+        }
+
+        _dispatching = true;
+
+        queue_node *recycled_first { nullptr }, *recycled_last { nullptr };
+
+        for (auto &position { state.batch_position }; position < state.batch_size; ++position)
+        {
+            auto node { state.batch[position] };
+
+            if (auto &[this_, args] = *node->item; this_) std::apply([this_](Args&... a){ this_->base_class::emit(std::move(a)...); }, args);
+
+            recycle_node(node, recycled_first, recycled_last);
+        }
+
+        auto count { state.batch_size };
+
+        state.batch_position = state.batch_size = 0;
+
+        release_nodes(state, recycled_first, recycled_last);
+        consumed(state, count);
+
+        _dispatching = false;
+
+        return count;
     }
 
     /**
-     * @brief Checks if delay is used between emissions
-     * @return true if delay is used, false otherwise
+     * @brief Accounts for emissions taken off the queue and wakes blocked producers
      */
-    static bool use_delay() noexcept
+    static void consumed(dispatcher_state &state, size_t count)
     {
-        return _use_delay;
+        if (count == 0) return;
+
+        state.size.fetch_sub(count);
+
+        if (state.blocked_producers.load() > 0) state.size.notify_all();
     }
 
     /**
-     * @brief Sets whether all pending signals should be dispatched on destroy
-     * @param do_dispatch true to dispatch all pending signals, false otherwise
+     * @brief Queues an emission in the shared queue, applying the overflow policy if it is full
+     * @param args Arguments to pass to the slots
      */
-    void set_dispatch_all_on_destroy(bool do_dispatch) noexcept
+    template<typename... T>
+    void enqueue(T &&... args)
     {
-        _dispatch_all_on_destroy = do_dispatch;
+        auto &state { *_dispatcher };
+
+        if (auto capacity { state.capacity.load(std::memory_order_relaxed) }; capacity > 0 && state.size.load() >= capacity && !make_room(state, std::forward<T>(args)...)) return;
+
+        state.size.fetch_add(1);
+
+        auto node { acquire_node(state) };
+
+        node->item.emplace(this, std::tuple<Args...>(std::forward<T>(args)...));
+        node->next.store(nullptr, std::memory_order_relaxed);
+
+        state.tail.exchange(node)->next.store(node);
+
+        std::call_once(state.started, [&state]{ state.thread = std::jthread(&queue_dispatcher); });
+
+        if (state.waiting.load())
+        {
+            state.wakeups.fetch_add(1);
+            state.wakeups.notify_one();
+        }
     }
 
     /**
-     * @brief Checks if all pending signals will be dispatched on destroy
-     * @return true if all pending signals will be dispatched, false otherwise
+     * @brief Applies the overflow policy to an emission into a full queue
+     * 
+     * The arguments are only moved from if the emission is coalesced.
+     * 
+     * @return true if the emission should still be queued, false if it was dropped or coalesced
      */
-    bool get_dispatch_all_on_destroy() const noexcept
+    template<typename... T>
+    bool make_room(dispatcher_state &state, T &&... args)
     {
-        return _dispatch_all_on_destroy;
+        auto is_full { [&state]{ auto capacity { state.capacity.load() }; return capacity > 0 && state.size.load() >= capacity; } };
+        auto policy { state.policy.load() };
+
+        if (policy == overflow_policy::drop_newest)
+        {
+            ++state.dropped;
+
+            return false;
+        }
+
+        if (policy == overflow_policy::block)
+        {
+            if (_dispatching) return true;
+
+            ++state.blocked_producers;
+
+            for (auto size { state.size.load() }; is_full(); size = state.size.load()) state.size.wait(size);
+
+            --state.blocked_producers;
+
+            return true;
+        }
+
+        std::scoped_lock lock(state.queue_lock);
+
+        if (!is_full()) return true;
+
+        if (policy == overflow_policy::coalesce_by_key)
+        {
+            if (auto queued_args { find_coalescable(state, args...) })
+            {
+                *queued_args = std::tuple<Args...>(std::forward<T>(args)...);
+
+                ++state.coalesced;
+
+                return false;
+            }
+        }
+
+        if (auto node { pop_node(state) })
+        {
+            queue_node *recycled_first { nullptr }, *recycled_last { nullptr };
+
+            recycle_node(node, recycled_first, recycled_last);
+            release_nodes(state, recycled_first, recycled_last);
+        }
+        else return true;
+
+        ++state.dropped;
+
+        consumed(state, 1);
+
+        return true;
     }
 
-protected:
-    static inline std::deque<std::tuple<queued_signal_base*, std::tuple<Args...>>> _signal_queue {};
-    static inline std::mutex _emit_lock {}, _destruct_lock {};
-    static inline std::atomic<std::chrono::milliseconds> _delay_ms { 0ms };
-    static inline std::jthread _dispatcher_thread {};
-    static inline std::atomic_bool _use_delay { false }, _thread_running { false }, _dispatch_all_on_destroy { true };
+    /**
+     * @brief Finds the queued arguments of this signal an emission can be coalesced into; the queue lock must be held
+     * @return Pointer to the queued arguments, or nullptr if there are none with the same key
+     */
+    std::tuple<Args...> *find_coalescable(dispatcher_state &state, const Args &... args)
+    {
+        std::tuple<Args...> *found { nullptr };
+        auto matches { [this, key = _coalesce_key ? _coalesce_key(args...) : 0](queued_item &item)
+        {
+            return std::get<0>(item) == this && (!_coalesce_key || std::apply(_coalesce_key, std::get<1>(item)) == key);
+        } };
+
+        for (auto node { state.head }; node; node = node->next.load())
+        {
+            if (node == &state.stub || !matches(*node->item)) continue;
+
+            found = &std::get<1>(*node->item);
+
+            if (_coalesce_key) return found;
+        }
+
+        return found;
+    }
 
     /**
      * @brief Thread function that dispatches queued signals
@@ -1629,30 +6763,27 @@ protected:
      */
     static void queue_dispatcher(std::stop_token cancelled)
     {
-        while (cancelled.stop_requested() == false)
+        auto &state { dispatcher() };
+
+        while (!cancelled.stop_requested())
         {
-            {
-                std::scoped_lock lock(_emit_lock);
+            auto use_delay { _use_delay.load() };
 
-                if (cancelled.stop_requested() || std::empty(_signal_queue)) break;
+            if (dispatch_batch(state, use_delay ? 1 : std::size(state.batch)) > 0)
+            {
+                if (use_delay) std::this_thread::sleep_for(_delay_ms.load());
 
-                auto &[this_, args] = _signal_queue.front();
+                continue;
+            }
 
-                std::apply([&this_](const Args&... a){ this_->base_class::emit(a...); }, args);
+            auto seen { state.wakeups.load() };
 
-                _signal_queue.pop_front();
+            state.waiting = true;
 
-                if (std::empty(_signal_queue))
-                {
-                    _thread_running = false;
-                    break;
-                }
-            }
+            if (!cancelled.stop_requested() && dispatch_batch(state, 1) == 0) state.wakeups.wait(seen);
 
-            if (_use_delay) std::this_thread::sleep_for(_delay_ms.load());
+            state.waiting = false;
         }
-
-        _thread_running = false;
     }
 };
 
@@ -1682,9 +6813,21 @@ template<typename scope, typename... Args> using queued_signal_scoped = queued_s
  */
 template<typename scope, typename... Args> using queued_signal_ex_scoped = queued_signal_base<scope, signal_ex, Args...>;
 
+/**
+ * @brief Type alias for a queued signal that records metrics
+ * 
+ * Its queue gauges report the queue shared by all signals of the default scope.
+ * 
+ * @tparam Args Types of arguments the signal passes to slots
+ */
+template<typename... Args> using instrumented_queued_signal = queued_signal_base<queued_signal_default_scope, instrumented_signal, Args...>;
+
 /**
  * @brief A signal that emits at regular intervals
  * 
+ * The ticks are scheduled on a timer service (the process-wide one by default), so the
+ * signal does not own a thread and the period does not drift.
+ * 
  * @tparam Args Types of arguments the signal passes to slots
  */
 template<std::copyable... Args>
@@ -1705,6 +6848,15 @@ public:
      */
     template<typename Duration>
     timer_signal(const std::u8string &name, const Duration &timer_ms = 1s) : base_class{ name }, _timer_ms{ std::chrono::duration_cast<std::chrono::milliseconds>(timer_ms) } {}
+
+    /**
+     * @brief Constructor with a name, timer duration and the timer service to schedule ticks on
+     * @param name The name of the signal
+     * @param timer_ms The timer interval
+     * @param service The timer service; it must outlive the signal
+     */
+    template<typename Duration>
+    timer_signal(const std::u8string &name, const Duration &timer_ms, timer_service &service) : base_class{ name }, _timer_ms{ std::chrono::duration_cast<std::chrono::milliseconds>(timer_ms) }, _timer_service{ &service } {}
     
     /**
      * @brief Move constructor
@@ -1735,143 +6887,215 @@ public:
     {
         if (!_timer_enabled.exchange(true))
         {
-            _args = std::make_tuple(this, args...);
+            {
+                std::scoped_lock lock(_emit_lock);
 
-            if (_timer_thread.joinable()) _timer_thread.join();
+                _args = std::make_tuple(this, args...);
+            }
 
-            _sleep.reset();
+            std::scoped_lock lock(_timer_lock);
 
-            _timer_thread = std::jthread([this](){ timer_procedure(); });
+            _timer = _timer_service->schedule_every(_timer_ms.load(), [this]{ timer_procedure(); });
         }
     }
 
     /**
-     * @brief Stops the timer
+     * @brief Stops the timer, waiting for a running tick to finish unless called from a slot
      */
     void stop_timer()
     {
-        _sleep.cancel_wait();
+        timer_service::timer_handle timer;
+
+        {
+            std::scoped_lock lock(_timer_lock);
+
+            timer = std::move(_timer);
+        }
 
-        if (_timer_thread.joinable()) _timer_thread.join();
+        _timer_service->cancel(timer);
+
+        _timer_enabled = false;
     }
 
     /**
      * @brief Disables the timer from a slot
      */
-    void disable_timer_from_slot() noexcept
+    void disable_timer_from_slot()
+    {
+        stop_timer();
+    }
+
+    /**
+     * @brief Sets the timer interval
+     * @param duration The new timer interval
+     */
+    template<typename Duration>
+    void timer_ms(const Duration &duration)
+    {
+        _timer_ms.store(std::chrono::duration_cast<std::chrono::milliseconds>(duration));
+
+        std::scoped_lock lock(_timer_lock);
+
+        if (_timer) _timer->period = std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(_timer_ms.load()), std::chrono::nanoseconds{ 1 });
+    }
+
+    /**
+     * @brief Gets the timer interval
+     * @return The timer interval in microseconds
+     */
+    std::chrono::microseconds timer_ms() const noexcept
+    {
+        return _timer_ms.load();
+    }
+
+private:
+
+    std::atomic_bool _timer_enabled { false };
+    std::atomic<std::chrono::milliseconds> _timer_ms { 1s };
+    timer_service *_timer_service { &timer_service::global() };
+    timer_service::timer_handle _timer {};
+    mutable std::mutex _emit_lock {}, _timer_lock {};
+    std::tuple<timer_signal*, Args...> _args {};
+
+    /**
+     * @brief Timer callback that emits the signal
+     */
+    void timer_procedure()
+    {
+        std::scoped_lock lock(_emit_lock);
+
+        std::apply([this](timer_signal *s, const Args&... a){ base_class::emit(s, a...); }, _args);
+    }
+};
+
+/**
+ * @brief Hash of the keys of a signal set
+ * 
+ * Falls back to std::hash for keys other than strings.
+ * 
+ * @tparam Key The key type
+ */
+template<typename Key>
+struct signal_set_hash : std::hash<Key> {};
+
+/**
+ * @brief Transparent hash of string keys, so that they can be looked up by string views or literals without allocating
+ * 
+ * @tparam CharT The character type
+ * @tparam Traits The character traits
+ * @tparam Alloc The allocator type
+ */
+template<typename CharT, typename Traits, typename Alloc>
+struct signal_set_hash<std::basic_string<CharT, Traits, Alloc>>
+{
+    using is_transparent = void;
+
+    size_t operator()(std::basic_string_view<CharT, Traits> key) const noexcept
     {
-        _sleep.cancel_wait();
+        return std::hash<std::basic_string_view<CharT, Traits>>{}(key);
     }
+};
+
+/**
+ * @brief A collection of signals indexed by a key
+ * 
+ * The set is safe to use from many threads: it is split into shards by the hash of the
+ * key, each guarded by its own reader-writer lock, so looking up an existing signal only
+ * takes a shared lock on one shard. Signals are never removed, so references to them
+ * stay valid for the lifetime of the set. Iterating with begin() and end() is not
+ * synchronized with the creation of new signals.
+ * 
+ * String keys are hashed transparently: signals can be looked up by a string view or a
+ * literal without building a key, which only happens when a signal is created.
+ * 
+ * @tparam Key The key type for indexing signals
+ * @tparam SignalType The signal type
+ * @tparam Args Types of arguments the signals pass to slots
+ */
+template<typename Key, template <typename...> typename SignalType, typename... Args>
+requires std::derived_from<SignalType<Args...>, signal_base>
+class signal_set_base
+{
+public:
+    using signal_type = SignalType<Args...>;
+    using key_type = Key;
+    using hasher = signal_set_hash<Key>;
+    using map_type = std::unordered_map<key_type, std::unique_ptr<signal_type>, hasher, std::equal_to<>>;
 
     /**
-     * @brief Sets the timer interval
-     * @param duration The new timer interval
+     * @brief Checks if a key can be looked up without converting it to the key type
      */
-    template<typename Duration>
-    void timer_ms(const Duration &duration) noexcept
-    {
-        _timer_ms.store(std::chrono::duration_cast<std::chrono::milliseconds>(duration));
-    }
+    template<typename K>
+    static constexpr bool is_transparent_v { requires { typename hasher::is_transparent; } && !std::same_as<std::remove_cvref_t<K>, key_type> && std::is_invocable_v<const hasher&, const K&> && std::constructible_from<key_type, const K&> };
 
     /**
-     * @brief Gets the timer interval
-     * @return The timer interval in microseconds
+     * @brief Iterator over the signals of all shards
      */
-    std::chrono::microseconds timer_ms() const noexcept
+    class const_iterator
     {
-        return _timer_ms.load();
-    }
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = typename map_type::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
 
-private:
+        const_iterator() = default;
 
-    std::atomic_bool _timer_enabled { false };
-    std::jthread _timer_thread {};
-    std::atomic<std::chrono::milliseconds> _timer_ms { 1s };
-    mutable std::mutex _emit_lock {};
-    std::tuple<timer_signal*, Args...> _args {};
-    
-    /**
-     * @brief Helper class for timer sleep with cancellation
-     */
-    class
-    {
-    public:
-        /**
-         * @brief Waits for the specified duration or until cancelled
-         * @param duration The duration to wait
-         * @return true if the wait completed normally, false if it was cancelled
-         */
-        bool wait_for(const std::chrono::milliseconds &duration)
+        const_iterator(const signal_set_base *set, size_t shard) : _set{ set }, _shard{ shard }
         {
-            std::unique_lock<std::mutex> lock { _m };
+            if (_shard < _set->_shard_count) _position = std::begin(_set->_shards[_shard].signals);
 
-            return !_cv.wait_for(lock, duration, [this]{ return _cancelled.load(); });
+            skip_empty();
         }
 
-        /**
-         * @brief Cancels any ongoing wait
-         */
-        void cancel_wait()
+        reference operator*() const { return *_position; }
+        pointer operator->() const { return &*_position; }
+
+        const_iterator &operator++()
         {
-            _cancelled = true;
+            ++_position;
 
-            _cv.notify_all();
+            skip_empty();
+
+            return *this;
         }
 
-        /**
-         * @brief Resets the cancellation state
-         */
-        void reset()
+        const_iterator operator++(int) { auto previous { *this }; ++*this; return previous; }
+
+        bool operator==(const const_iterator &other) const noexcept
         {
-            _cancelled = false;
+            return _shard == other._shard && (!_set || _shard == _set->_shard_count || _position == other._position);
         }
 
     private:
+        const signal_set_base *_set { nullptr };
+        size_t _shard { 0 };
+        typename map_type::const_iterator _position {};
 
-        std::condition_variable _cv {};
-        std::mutex _m {};
-        std::atomic_bool _cancelled { false };
-    } _sleep;
-
-
-    /**
-     * @brief Timer procedure that emits the signal at regular intervals
-     */
-    void timer_procedure()
-    {
-        while (_sleep.wait_for(_timer_ms.load()))
+        void skip_empty()
         {
+            while (_shard < _set->_shard_count && _position == std::end(_set->_shards[_shard].signals))
             {
-                std::scoped_lock lock(_emit_lock);
-
-                std::apply([this](timer_signal *s, const Args&... a){ base_class::emit(s, a...); }, _args);
+                if (++_shard < _set->_shard_count) _position = std::begin(_set->_shards[_shard].signals);
             }
         }
+    };
 
-        _timer_enabled = false;
-    }
-};
-
-/**
- * @brief A collection of signals indexed by a key
- * 
- * @tparam Key The key type for indexing signals
- * @tparam SignalType The signal type
- * @tparam Args Types of arguments the signals pass to slots
- */
-template<typename Key, template <typename...> typename SignalType, typename... Args>
-requires std::derived_from<SignalType<Args...>, signal_base>
-class signal_set_base
-{
-public:
-    using signal_type = SignalType<Args...>;
-    using key_type = Key;
+    /**
+     * @brief Default constructor of a set with a single shard
+     */
+    signal_set_base() : signal_set_base{ 1 } {}
 
     /**
-     * @brief Default constructor
+     * @brief Constructor with the number of shards
+     * 
+     * Use more shards when many threads look up or create signals concurrently.
+     * 
+     * @param shard_count Number of independently locked parts of the set
      */
-    signal_set_base() = default;
-    
+    explicit signal_set_base(size_t shard_count) : _shard_count{ std::max<size_t>(shard_count, 1) }, _shards{ std::make_unique<shard[]>(_shard_count) } {}
+
     /**
      * @brief Virtual destructor
      */
@@ -1879,11 +7103,61 @@ public:
 
     /**
      * @brief Emits all signals with the given arguments
+     * 
+     * The signals existing when the call starts are emitted without holding any lock of
+     * the set, so slots may create new signals in it.
+     * 
      * @param args Arguments to pass to the slots
      */
     void emit(const Args &... args) const
     {
-        for (auto &&s : _signals) s.second->emit(args...);
+        for (auto signal : get_signals()) signal->emit(args...);
+    }
+
+    /**
+     * @brief Emits all signals with the given arguments in parallel and waits for completion
+     * 
+     * The signals existing when the call starts are split into chunks of consecutive
+     * signals, which are emitted concurrently by the calling thread and by tasks posted
+     * to the set's executor. Every signal is emitted exactly once. Within a chunk the
+     * signals are emitted in iteration order, and the slots of each signal in order of
+     * their priority; there is no order between chunks. The calling thread keeps taking
+     * chunks until none is left, so the call cannot deadlock when it runs on the
+     * executor's own threads. Without an executor, or with a single chunk, this is the
+     * same as emit. If slots throw, the first exception is rethrown once all chunks are
+     * done.
+     * 
+     * @param args Arguments to pass to the slots
+     */
+    void emit_parallel(const Args &... args) const
+    {
+        auto signals { get_signals() };
+        auto executor { _executor.load(std::memory_order_acquire) };
+        auto chunk_size { _chunk_size.load(std::memory_order_relaxed) };
+        auto threads { std::max(std::thread::hardware_concurrency(), 1u) };
+
+        if (chunk_size == 0) chunk_size = std::max<size_t>(std::size(signals) / (threads * 4), 1);
+
+        auto chunk_count { (std::size(signals) + chunk_size - 1) / chunk_size };
+
+        if (!executor || chunk_count < 2)
+        {
+            for (auto signal : signals) signal->emit(args...);
+
+            return;
+        }
+
+        auto state { std::make_shared<fan_out<const Args&...>>(std::move(signals), chunk_size, chunk_count, args...) };
+
+        try
+        {
+            for (size_t task = 0; task < std::min<size_t>(chunk_count - 1, threads); ++task) (*executor)([state]{ while (state->emit_next_chunk()); });
+        }
+        catch (...) {}
+
+        while (state->emit_next_chunk());
+
+        state->wait();
     }
 
     /**
@@ -1895,6 +7169,33 @@ public:
         emit(args...);
     }
 
+    /**
+     * @brief Sets the executor running the chunks of emit_parallel
+     * @param executor The executor; emit_parallel emits sequentially if it is empty
+     */
+    void set_executor(executor_type executor)
+    {
+        _executor.store(executor ? std::make_shared<const executor_type>(std::move(executor)) : nullptr, std::memory_order_release);
+    }
+
+    /**
+     * @brief Sets the number of signals emitted by one task of emit_parallel
+     * @param chunk_size Signals per chunk; zero splits the set into about four chunks per hardware thread
+     */
+    void set_chunk_size(size_t chunk_size) noexcept
+    {
+        _chunk_size.store(chunk_size, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Gets the number of signals emitted by one task of emit_parallel
+     * @return Signals per chunk, zero if chosen automatically
+     */
+    size_t get_chunk_size() const noexcept
+    {
+        return _chunk_size.load(std::memory_order_relaxed);
+    }
+
     /**
      * @brief Gets or creates a signal for the given key
      * @param key The key to look up
@@ -1902,13 +7203,25 @@ public:
      */
     [[nodiscard]] virtual signal_type &get_signal(const key_type &key)
     {
-        auto signal { _signals.find(key) };
-
-        if (signal != _signals.end()) return *signal->second;
+        return find_or_create(key);
+    }
 
-        if constexpr (std::is_same_v<std::decay_t<key_type>, std::u8string>) return *_signals.emplace(key, std::make_unique<signal_type>(key)).first->second;
+    /**
+     * @brief Gets or creates a signal for a key given as another type, such as a string view
+     * 
+     * The key is only converted to the key type if the signal has to be created, which
+     * goes through the virtual overload taking the key type.
+     * 
+     * @param key The key to look up
+     * @return Reference to the signal
+     */
+    template<typename K>
+    requires is_transparent_v<K>
+    [[nodiscard]] signal_type &get_signal(const K &key)
+    {
+        if (auto signal { find(key) }) return *signal;
 
-        return *_signals.emplace(key, std::make_unique<signal_type>()).first->second;
+        return get_signal(key_type(key));
     }
 
     /**
@@ -1918,7 +7231,19 @@ public:
      */
     bool exists(const key_type &key) const
     {
-        return _signals.find(key) != _signals.end();
+        return find(key) != nullptr;
+    }
+
+    /**
+     * @brief Checks if a signal exists for a key given as another type, such as a string view
+     * @param key The key to look up
+     * @return true if a signal exists, false otherwise
+     */
+    template<typename K>
+    requires is_transparent_v<K>
+    bool exists(const K &key) const
+    {
+        return find(key) != nullptr;
     }
 
     /**
@@ -1929,7 +7254,12 @@ public:
     {
         std::unordered_set<key_type> signal_keys;
 
-        for (const auto &[key, _] : _signals) signal_keys.insert(key);
+        for (auto &&s : std::span { _shards.get(), _shard_count })
+        {
+            std::shared_lock lock(s.lock);
+
+            for (const auto &[key, _] : s.signals) signal_keys.insert(key);
+        }
 
         return signal_keys;
     }
@@ -1940,7 +7270,25 @@ public:
      */
     [[nodiscard]] auto get_signal_count() const
     {
-        return std::size(_signals);
+        size_t count { 0 };
+
+        for (auto &&s : std::span { _shards.get(), _shard_count })
+        {
+            std::shared_lock lock(s.lock);
+
+            count += std::size(s.signals);
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Gets the number of shards
+     * @return The number of independently locked parts of the set
+     */
+    [[nodiscard]] size_t get_shard_count() const noexcept
+    {
+        return _shard_count;
     }
 
     /**
@@ -1953,26 +7301,187 @@ public:
         return get_signal(key);
     }
 
+    /**
+     * @brief Subscript operator to get or create a signal by a key given as another type, such as a string view
+     * @param key The key to look up
+     * @return Reference to the signal
+     */
+    template<typename K>
+    requires is_transparent_v<K>
+    [[nodiscard]] signal_type &operator[](const K &key)
+    {
+        return get_signal(key);
+    }
+
     /**
      * @brief Iterator to the beginning of the signals
      * @return Iterator to the beginning
      */
-    auto begin() const
+    const_iterator begin() const
     {
-        return std::begin(_signals);
+        return { this, 0 };
     }
 
     /**
      * @brief Iterator to the end of the signals
      * @return Iterator to the end
      */
-    auto end() const
+    const_iterator end() const
     {
-        return std::end(_signals);
+        return { this, _shard_count };
     }
 
 protected:
-    std::unordered_map<key_type, std::unique_ptr<signal_type>> _signals {};
+    /**
+     * @brief A part of the set guarded by its own lock
+     */
+    struct alignas(64) shard
+    {
+        mutable std::shared_mutex lock {};
+        map_type signals {};
+    };
+
+    /**
+     * @brief The chunks of a parallel emission, shared with the tasks emitting them
+     * 
+     * Tasks that start after all chunks have been taken return without touching the
+     * arguments, which are only valid until the emitting call returns.
+     */
+    template<typename... EmitArgs>
+    struct fan_out
+    {
+        std::vector<signal_type*> signals;
+        size_t chunk_size, chunk_count;
+        std::tuple<EmitArgs...> args;
+        std::atomic_size_t next { 0 }, done { 0 };
+        std::atomic_flag failed {};
+        std::exception_ptr error {};
+
+        fan_out(std::vector<signal_type*> &&s, size_t size, size_t count, EmitArgs... a) : signals{ std::move(s) }, chunk_size{ size }, chunk_count{ count }, args{ a... } {}
+
+        /**
+         * @brief Takes the next chunk and emits its signals
+         * @return false if no chunk was left
+         */
+        bool emit_next_chunk()
+        {
+            auto chunk { next.fetch_add(1) };
+
+            if (chunk >= chunk_count) return false;
+
+            auto first { chunk * chunk_size };
+
+            for (auto signal : std::span { signals }.subspan(first, std::min(chunk_size, std::size(signals) - first)))
+            {
+                try
+                {
+                    std::apply([signal](const auto &... a){ signal->emit(a...); }, args);
+                }
+                catch (...)
+                {
+                    if (!failed.test_and_set()) error = std::current_exception();
+                }
+            }
+
+            if (done.fetch_add(1) + 1 == chunk_count) done.notify_all();
+
+            return true;
+        }
+
+        /**
+         * @brief Waits until all chunks are emitted and rethrows the first exception thrown by a slot
+         */
+        void wait()
+        {
+            for (auto count { done.load() }; count < chunk_count; count = done.load()) done.wait(count);
+
+            if (error) std::rethrow_exception(error);
+        }
+    };
+
+    size_t _shard_count;
+    std::unique_ptr<shard[]> _shards;
+    std::atomic<std::shared_ptr<const executor_type>> _executor {};
+    std::atomic_size_t _chunk_size { 0 };
+
+    /**
+     * @brief Called once for every new signal, before it is published
+     * @param signal The new signal
+     */
+    virtual void on_signal_created(signal_type &) {}
+
+    /**
+     * @brief Takes a snapshot of the signals of all shards
+     * @return Pointers to the signals
+     */
+    std::vector<signal_type*> get_signals() const
+    {
+        std::vector<signal_type*> signals;
+
+        for (auto &&s : std::span { _shards.get(), _shard_count })
+        {
+            std::shared_lock lock(s.lock);
+
+            for (auto &&[key, signal] : s.signals) signals.push_back(signal.get());
+        }
+
+        return signals;
+    }
+
+    /**
+     * @brief Gets the shard holding a key
+     * @param key The key
+     * @return Reference to the shard
+     */
+    template<typename K>
+    shard &get_shard(const K &key) const
+    {
+        return _shards[_shard_count == 1 ? 0 : hasher{}(key) % _shard_count];
+    }
+
+    /**
+     * @brief Finds the signal of a key
+     * @param key The key to look up
+     * @return Pointer to the signal, or nullptr if there is none
+     */
+    template<typename K>
+    signal_type *find(const K &key) const
+    {
+        auto &s { get_shard(key) };
+
+        std::shared_lock lock(s.lock);
+
+        auto signal { s.signals.find(key) };
+
+        return signal != std::end(s.signals) ? signal->second.get() : nullptr;
+    }
+
+    /**
+     * @brief Finds the signal of a key, creating it if there is none
+     * @param key The key to look up
+     * @return Reference to the signal
+     */
+    template<typename K>
+    signal_type &find_or_create(const K &key)
+    {
+        if (auto signal { find(key) }) return *signal;
+
+        auto &s { get_shard(key) };
+
+        std::unique_lock lock(s.lock);
+
+        if (auto signal { s.signals.find(key) }; signal != std::end(s.signals)) return *signal->second;
+
+        key_type new_key(key);
+        std::unique_ptr<signal_type> signal {};
+
+        if constexpr (std::is_same_v<std::decay_t<key_type>, std::u8string>) signal = std::make_unique<signal_type>(new_key);
+        else signal = std::make_unique<signal_type>();
+
+        on_signal_created(*signal);
+
+        return *s.signals.emplace(std::move(new_key), std::move(signal)).first->second;
+    }
 };
 
 /**
@@ -1997,26 +7506,31 @@ public:
     bridged_signal_set_base(const std::function<bool(typename base_class::signal_type::bridged_signal_type*)>& emit_functor) : base_class {}, _emit_functor { emit_functor } {}
 
     /**
-     * @brief Gets or creates a signal for the given key
-     * @param key The key to look up
-     * @return Reference to the signal
+     * @brief Constructor with emit functor and the number of shards
+     * @param emit_functor Function to call when signals are emitted
+     * @param shard_count Number of independently locked parts of the set
      */
-    [[nodiscard]] virtual typename base_class::signal_type &get_signal(const key_type &key) override
-    {
-        auto &signal { base_class::get_signal(key) };
-
-        if (!signal.get_emit_functor() && _emit_functor) signal.set_emit_functor(_emit_functor);
-
-        return signal;
-    }
+    bridged_signal_set_base(const std::function<bool(typename base_class::signal_type::bridged_signal_type*)>& emit_functor, size_t shard_count) : base_class { shard_count }, _emit_functor { emit_functor } {}
 
     /**
      * @brief Sets the emit functor for all signals
+     * 
+     * Signals that already have an emit functor keep it.
+     * 
      * @param emit_functor Function to call when signals are emitted
      */
     void set_emit_functor(const std::function<bool(typename base_class::signal_type::bridged_signal_type*)>& emit_functor)
     {
+        std::vector<std::unique_lock<std::shared_mutex>> locks;
+
+        for (auto &&s : std::span { base_class::_shards.get(), base_class::_shard_count }) locks.emplace_back(s.lock);
+
         _emit_functor = emit_functor;
+
+        if (!_emit_functor) return;
+
+        for (auto &&s : std::span { base_class::_shards.get(), base_class::_shard_count })
+            for (auto &&[key, signal] : s.signals) if (!signal->get_emit_functor()) signal->set_emit_functor(_emit_functor);
     }
 
     /**
@@ -2030,6 +7544,15 @@ public:
 
 protected:
     std::function<bool(typename base_class::signal_type::bridged_signal_type*)> _emit_functor { nullptr };
+
+    /**
+     * @brief Sets the emit functor of a new signal
+     * @param signal The new signal
+     */
+    virtual void on_signal_created(typename base_class::signal_type &signal) override
+    {
+        if (_emit_functor) signal.set_emit_functor(_emit_functor);
+    }
 };
 
 /**
@@ -2046,6 +7569,13 @@ template<typename Key, typename... Args> using signal_set = signal_set_base<Key,
  */
 template<typename Key, typename... Args> using signal_ex_set = signal_set_base<Key, signal_ex, Args...>;
 
+/**
+ * @brief Type alias for a concurrent signal set
+ * @tparam Key The key type for indexing signals
+ * @tparam Args Types of arguments the signals pass to slots
+ */
+template<typename Key, typename... Args> using concurrent_signal_set = signal_set_base<Key, concurrent_signal, Args...>;
+
 /**
  * @brief Type alias for a throttled signal set
  * @tparam Key The key type for indexing signals
@@ -2060,6 +7590,27 @@ template<typename Key, typename... Args> using throttled_signal_set = signal_set
  */
 template<typename Key, typename... Args> using throttled_signal_ex_set = signal_set_base<Key, throttled_signal_ex, Args...>;
 
+/**
+ * @brief Type alias for a rate-limited signal set
+ * @tparam Key The key type for indexing signals
+ * @tparam Args Types of arguments the signals pass to slots
+ */
+template<typename Key, typename... Args> using rate_limited_signal_set = signal_set_base<Key, rate_limited_signal, Args...>;
+
+/**
+ * @brief Type alias for a coalescing signal set, keeping the newest emission per key
+ * @tparam Key The key type for indexing signals
+ * @tparam Args Types of arguments the signals pass to slots
+ */
+template<typename Key, typename... Args> using coalescing_signal_set = signal_set_base<Key, coalescing_signal, Args...>;
+
+/**
+ * @brief Type alias for a coalescing extended signal set, keeping the newest emission per key
+ * @tparam Key The key type for indexing signals
+ * @tparam Args Types of arguments the signals pass to slots
+ */
+template<typename Key, typename... Args> using coalescing_signal_ex_set = signal_set_base<Key, coalescing_signal_ex, Args...>;
+
 /**
  * @brief Type alias for a queued signal set
  * @tparam Key The key type for indexing signals
@@ -0,0 +1,208 @@
+#pragma once
+
+/*
+MIT License
+Copyright (c) 2019 Arlen Keshabyan (arlen.albert@gmail.com)
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace nstd
+{
+
+/**
+ * @brief A move-only, type-erased callable with an inline small buffer
+ * 
+ * Callables that fit into the buffer and are nothrow move constructible are stored
+ * inline, so wrapping a typical capturing lambda does not allocate. Larger callables
+ * fall back to the heap.
+ * 
+ * @tparam Signature The call signature, e.g. void(int)
+ * @tparam Capacity Size of the inline buffer in bytes
+ */
+template<typename Signature, size_t Capacity = 48>
+class small_function;
+
+template<typename R, typename... Ts, size_t Capacity>
+class small_function<R(Ts...), Capacity>
+{
+public:
+    /**
+     * @brief Checks whether a callable of the given type is stored inline
+     * @tparam Functor The callable type
+     */
+    template<typename Functor>
+    static constexpr bool is_stored_inline { sizeof(Functor) <= Capacity && alignof(Functor) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Functor> };
+
+    /**
+     * @brief Default constructor creates an empty function
+     */
+    small_function() noexcept = default;
+
+    /**
+     * @brief Constructor creating an empty function
+     */
+    small_function(std::nullptr_t) noexcept {}
+
+    /**
+     * @brief Constructor wrapping a callable
+     * @param functor The callable to wrap
+     */
+    template<typename Functor>
+    requires (!std::same_as<std::remove_cvref_t<Functor>, small_function> && std::is_invocable_r_v<R, std::decay_t<Functor>&, Ts...>)
+    small_function(Functor &&functor)
+    {
+        using functor_type = std::decay_t<Functor>;
+
+        if constexpr (is_stored_inline<functor_type>)
+            ::new (static_cast<void*>(_storage)) functor_type(std::forward<Functor>(functor));
+        else
+            ::new (static_cast<void*>(_storage)) functor_type*{ new functor_type(std::forward<Functor>(functor)) };
+
+        _invoker = &invoke<functor_type>;
+        _manager = &manage<functor_type>;
+    }
+
+    /**
+     * @brief Move constructor
+     * @param other The function to move from
+     */
+    small_function(small_function &&other) noexcept
+    {
+        take(other);
+    }
+
+    small_function(const small_function &other) = delete;
+    small_function &operator=(const small_function &other) = delete;
+
+    /**
+     * @brief Move assignment operator
+     * @param other The function to move from
+     * @return Reference to this function
+     */
+    small_function &operator=(small_function &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            take(other);
+        }
+
+        return *this;
+    }
+
+    /**
+     * @brief Destructor
+     */
+    ~small_function()
+    {
+        reset();
+    }
+
+    /**
+     * @brief Invokes the wrapped callable
+     * @param args Arguments to pass to the callable
+     * @return The callable's result
+     */
+    R operator()(Ts... args) const
+    {
+        return _invoker(const_cast<std::byte*>(_storage), std::forward<Ts>(args)...);
+    }
+
+    /**
+     * @brief Checks whether a callable is wrapped
+     * @return true if a callable is wrapped, false otherwise
+     */
+    explicit operator bool() const noexcept
+    {
+        return _invoker != nullptr;
+    }
+
+    /**
+     * @brief Destroys the wrapped callable
+     */
+    void reset() noexcept
+    {
+        if (_manager) _manager(operation::destroy, _storage, nullptr);
+
+        _invoker = nullptr;
+        _manager = nullptr;
+    }
+
+private:
+    enum class operation { move, destroy };
+
+    using invoker_type = R (*)(std::byte*, Ts&&...);
+    using manager_type = void (*)(operation, std::byte*, std::byte*) noexcept;
+
+    alignas(std::max_align_t) std::byte _storage[Capacity] {};
+    invoker_type _invoker { nullptr };
+    manager_type _manager { nullptr };
+
+    template<typename Functor>
+    static Functor &target(std::byte *storage) noexcept
+    {
+        if constexpr (is_stored_inline<Functor>)
+            return *std::launder(reinterpret_cast<Functor*>(storage));
+        else
+            return **std::launder(reinterpret_cast<Functor**>(storage));
+    }
+
+    template<typename Functor>
+    static R invoke(std::byte *storage, Ts&&... args)
+    {
+        return std::invoke(target<Functor>(storage), std::forward<Ts>(args)...);
+    }
+
+    template<typename Functor>
+    static void manage(operation op, std::byte *storage, std::byte *destination) noexcept
+    {
+        if constexpr (is_stored_inline<Functor>)
+        {
+            auto &functor { target<Functor>(storage) };
+
+            if (op == operation::move) ::new (static_cast<void*>(destination)) Functor(std::move(functor));
+
+            functor.~Functor();
+        }
+        else
+        {
+            auto *functor { *std::launder(reinterpret_cast<Functor**>(storage)) };
+
+            if (op == operation::move) ::new (static_cast<void*>(destination)) Functor*{ functor };
+            else delete functor;
+        }
+    }
+
+    void take(small_function &other) noexcept
+    {
+        if (!other._manager) return;
+
+        other._manager(operation::move, other._storage, _storage);
+
+        _invoker = std::exchange(other._invoker, nullptr);
+        _manager = std::exchange(other._manager, nullptr);
+    }
+};
+
+}
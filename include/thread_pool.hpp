@@ -20,15 +20,34 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <concepts>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
 #include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <iterator>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <new>
 #include <queue>
+#include <random>
+#include <ranges>
+#include <span>
 #include <stdexcept>
 #include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "timer_service.hpp"
 
 namespace nstd
 {
@@ -202,6 +221,334 @@ private:
     std::condition_variable _condition {};
 };
 
+template <typename T>
+class work_stealing_deque
+{
+    static_assert(std::is_trivially_copyable_v<T>, "work_stealing_deque stores trivially copyable items only");
+
+public:
+    explicit work_stealing_deque(int64_t capacity = 64)
+    {
+        _rings.push_back(std::make_unique<ring>(static_cast<int64_t>(std::bit_ceil(static_cast<uint64_t>(std::max<int64_t>(capacity, 2))))));
+        _ring.store(_rings.back().get(), std::memory_order_relaxed);
+    }
+
+    work_stealing_deque(const work_stealing_deque& rhs) = delete;
+    work_stealing_deque& operator=(const work_stealing_deque& rhs) = delete;
+
+    // owner thread only
+    void push(T item)
+    {
+        auto bottom { _bottom.load(std::memory_order_relaxed) };
+        auto top { _top.load(std::memory_order_acquire) };
+        auto items { _ring.load(std::memory_order_relaxed) };
+
+        if (bottom - top > items->capacity() - 1) items = grow(items, bottom, top);
+
+        items->store(bottom, item);
+
+        _bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    // owner thread only
+    bool pop(T& out)
+    {
+        auto bottom { _bottom.load(std::memory_order_relaxed) - 1 };
+        auto items { _ring.load(std::memory_order_relaxed) };
+
+        _bottom.store(bottom, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto top { _top.load(std::memory_order_relaxed) };
+
+        if (top > bottom)
+        {
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+
+            return false;
+        }
+
+        out = items->load(bottom);
+
+        if (top == bottom)
+        {
+            bool won { _top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed) };
+
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+
+            return won;
+        }
+
+        return true;
+    }
+
+    // any thread
+    bool steal(T& out)
+    {
+        auto top { _top.load(std::memory_order_acquire) };
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto bottom { _bottom.load(std::memory_order_acquire) };
+
+        if (top >= bottom) return false;
+
+        auto item { _ring.load(std::memory_order_acquire)->load(top) };
+
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) return false;
+
+        out = item;
+
+        return true;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    size_t size() const
+    {
+        auto bottom { _bottom.load(std::memory_order_relaxed) };
+        auto top { _top.load(std::memory_order_relaxed) };
+
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+private:
+    class ring
+    {
+    public:
+        explicit ring(int64_t capacity) : _mask { capacity - 1 }, _items { std::make_unique<std::atomic<T>[]>(static_cast<size_t>(capacity)) } { }
+
+        int64_t capacity() const { return _mask + 1; }
+        T load(int64_t index) const { return _items[index & _mask].load(std::memory_order_relaxed); }
+        void store(int64_t index, T item) { _items[index & _mask].store(item, std::memory_order_relaxed); }
+
+    private:
+        int64_t _mask;
+        std::unique_ptr<std::atomic<T>[]> _items;
+    };
+
+    // thieves may still read a replaced ring, so the rings live as long as the deque
+    ring* grow(ring* items, int64_t bottom, int64_t top)
+    {
+        auto bigger { std::make_unique<ring>(items->capacity() * 2) };
+
+        for (auto index { top }; index < bottom; ++index) bigger->store(index, items->load(index));
+
+        items = bigger.get();
+
+        _rings.push_back(std::move(bigger));
+        _ring.store(items, std::memory_order_release);
+
+        return items;
+    }
+
+    alignas(64) std::atomic<int64_t> _top { 0 };
+    alignas(64) std::atomic<int64_t> _bottom { 0 };
+    alignas(64) std::atomic<ring*> _ring { nullptr };
+    std::vector<std::unique_ptr<ring>> _rings {};
+};
+
+// process-wide free lists of fixed-size blocks for small task objects and future states;
+// every thread keeps its own cache and exchanges batches with the shared list, and blocks are
+// recycled but never returned to the system; the shared list is never destroyed, so tasks may
+// still be released by static destructors, and a thread whose cache is gone uses it directly
+class task_slot_pool
+{
+public:
+    static constexpr size_t slot_size { 128 };
+
+    template <typename T>
+    static constexpr bool fits { sizeof(T) <= slot_size && alignof(T) <= alignof(std::max_align_t) };
+
+    static void* allocate()
+    {
+        if (_cache_destroyed) return take_shared();
+
+        auto& cache { local_cache() };
+
+        if (!cache.free) refill(cache);
+
+        auto allocated { cache.free };
+
+        cache.free = allocated->next;
+        --cache.count;
+
+        return allocated;
+    }
+
+    static void deallocate(void* block) noexcept
+    {
+        auto released { ::new (block) slot };
+
+        if (_cache_destroyed)
+        {
+            give_shared(released, released);
+
+            return;
+        }
+
+        auto& cache { local_cache() };
+
+        released->next = cache.free;
+        cache.free = released;
+
+        if (++cache.count >= 2 * batch_size) spill(cache, batch_size);
+    }
+
+private:
+    static constexpr size_t batch_size { 64 };
+    static constexpr size_t slab_size { 256 };
+
+    union slot
+    {
+        slot* next;
+        alignas(std::max_align_t) std::byte storage[slot_size];
+    };
+
+    struct shared_list
+    {
+        std::mutex mutex {};
+        slot* free { nullptr };
+        std::vector<std::unique_ptr<slot[]>> slabs {};
+    };
+
+    struct thread_cache
+    {
+        slot* free { nullptr };
+        size_t count { 0 };
+
+        ~thread_cache()
+        {
+            spill(*this, count);
+
+            _cache_destroyed = true;
+        }
+    };
+
+    static inline thread_local bool _cache_destroyed { false };
+
+    static shared_list& shared()
+    {
+        static auto& list { *new shared_list };
+
+        return list;
+    }
+
+    static thread_cache& local_cache()
+    {
+        static thread_local thread_cache cache;
+
+        return cache;
+    }
+
+    // the caller must hold the lock of the shared list
+    static void add_slab(shared_list& list)
+    {
+        list.slabs.push_back(std::make_unique<slot[]>(slab_size));
+
+        for (auto& block : std::span { list.slabs.back().get(), slab_size }) block.next = list.free, list.free = &block;
+    }
+
+    static void* take_shared()
+    {
+        auto& list { shared() };
+        std::scoped_lock lock { list.mutex };
+
+        if (!list.free) add_slab(list);
+
+        return std::exchange(list.free, list.free->next);
+    }
+
+    static void give_shared(slot* first, slot* last) noexcept
+    {
+        auto& list { shared() };
+        std::scoped_lock lock { list.mutex };
+
+        last->next = list.free;
+        list.free = first;
+    }
+
+    static void refill(thread_cache& cache)
+    {
+        auto& list { shared() };
+        std::scoped_lock lock { list.mutex };
+
+        if (!list.free) add_slab(list);
+
+        while (list.free && cache.count < batch_size)
+        {
+            auto taken { list.free };
+
+            list.free = taken->next;
+            taken->next = cache.free;
+            cache.free = taken;
+            ++cache.count;
+        }
+    }
+
+    static void spill(thread_cache& cache, size_t count)
+    {
+        if (count == 0) return;
+
+        auto first { cache.free };
+        auto last { first };
+
+        for (size_t index = 1; index < count; ++index) last = last->next;
+
+        cache.free = last->next;
+        cache.count -= count;
+
+        give_shared(first, last);
+    }
+};
+
+template <typename T>
+class task_slot_allocator
+{
+public:
+    using value_type = T;
+
+    task_slot_allocator() = default;
+    template <typename U> task_slot_allocator(const task_slot_allocator<U>&) noexcept { }
+
+    T* allocate(size_t count)
+    {
+        if (count == 1 && task_slot_pool::fits<T>) return static_cast<T*>(task_slot_pool::allocate());
+
+        return std::allocator<T>{}.allocate(count);
+    }
+
+    void deallocate(T* pointer, size_t count) noexcept
+    {
+        if (count == 1 && task_slot_pool::fits<T>) task_slot_pool::deallocate(pointer);
+        else std::allocator<T>{}.deallocate(pointer, count);
+    }
+
+    template <typename U> bool operator==(const task_slot_allocator<U>&) const noexcept { return true; }
+};
+
+enum class task_priority
+{
+    high,
+    normal,
+    low
+};
+
+struct task_lane_metrics
+{
+    uint64_t submitted { 0 };
+    uint64_t started { 0 };
+    uint64_t deadline_misses { 0 };
+    uint64_t starvation_promotions { 0 };
+    std::chrono::nanoseconds total_wait { 0 };
+    std::chrono::nanoseconds max_wait { 0 };
+    size_t queued { 0 };
+};
+
 class thread_pool
 {
 private:
@@ -215,13 +562,15 @@ private:
         thread_task_base(thread_task_base&& other) = default;
         thread_task_base& operator=(thread_task_base&& other) = default;
         virtual void execute() = 0;
+        virtual void release() noexcept = 0;
     };
 
     template <typename Functor>
     class thread_task: public thread_task_base
     {
     public:
-        thread_task(Functor&& functor) :_functor { std::move(functor) } { }
+        template <typename F>
+        explicit thread_task(F&& functor) :_functor { std::forward<F>(functor) } { }
         ~thread_task() override = default;
         thread_task(const thread_task& rhs) = delete;
         thread_task& operator=(const thread_task& rhs) = delete;
@@ -229,18 +578,227 @@ private:
         thread_task& operator=(thread_task&& other) = default;
         void execute() override { _functor(); }
 
+        void release() noexcept override
+        {
+            if constexpr (task_slot_pool::fits<thread_task>)
+            {
+                void* slot { this };
+
+                this->~thread_task();
+
+                task_slot_pool::deallocate(slot);
+            }
+            else delete this;
+        }
+
     private:
         Functor _functor;
     };
 
+    struct task_releaser
+    {
+        void operator()(thread_task_base* task) const noexcept { task->release(); }
+    };
+
+    using task_pointer = std::unique_ptr<thread_task_base, task_releaser>;
+    using task_deque = work_stealing_deque<thread_task_base*>;
+
+    struct worker_context
+    {
+        thread_pool* pool;
+        size_t index;
+    };
+
+    using clock_type = std::chrono::steady_clock;
+
+    static constexpr int64_t no_deadline { std::numeric_limits<int64_t>::max() };
+    static constexpr size_t lane_count { 3 };
+
+    static int64_t now_ns()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count();
+    }
+
+    struct lane_entry
+    {
+        thread_task_base* task;
+        int64_t enqueued;
+        int64_t deadline;
+        uint64_t sequence;
+    };
+
+    // tasks without a deadline get one at their enqueue time plus the lane's starvation limit and
+    // queue FIFO in a ring, tasks with a deadline go to a heap; the earlier of both fronts runs first
+    class task_lane
+    {
+    public:
+        void push(thread_task_base* task, int64_t enqueued, int64_t deadline)
+        {
+            std::scoped_lock lock { _mutex };
+
+            push_locked(task, enqueued, deadline);
+        }
+
+        // ownership of each task passes to the lane as soon as it is queued
+        void push(std::vector<task_pointer>& tasks, int64_t enqueued)
+        {
+            std::scoped_lock lock { _mutex };
+
+            for (auto& task : tasks) push_locked(task.get(), enqueued, no_deadline), (void)task.release();
+        }
+
+        bool pop(thread_task_base*& task, int64_t now)
+        {
+            if (empty()) return false;
+
+            std::scoped_lock lock { _mutex };
+
+            if (_ring_count == 0 && std::empty(_heap)) return false;
+
+            lane_entry entry;
+
+            if (_ring_count > 0 && (std::empty(_heap) || !later(_ring[_ring_head], _heap.front())))
+            {
+                entry = _ring[_ring_head];
+                _ring_head = (_ring_head + 1) % std::size(_ring);
+                --_ring_count;
+            }
+            else
+            {
+                std::pop_heap(std::begin(_heap), std::end(_heap), later);
+
+                entry = _heap.back();
+
+                _heap.pop_back();
+
+                if (now > entry.deadline) _deadline_misses.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            published();
+
+            auto wait { static_cast<uint64_t>(std::max<int64_t>(now - entry.enqueued, 0)) };
+
+            _started.fetch_add(1, std::memory_order_relaxed);
+            _total_wait.fetch_add(wait, std::memory_order_relaxed);
+
+            for (auto max_wait { _max_wait.load(std::memory_order_relaxed) }; wait > max_wait && !_max_wait.compare_exchange_weak(max_wait, wait, std::memory_order_relaxed);) { }
+
+            task = entry.task;
+
+            return true;
+        }
+
+        bool empty() const { return _count.load(std::memory_order_acquire) == 0; }
+        int64_t earliest_deadline() const { return _earliest.load(std::memory_order_acquire); }
+
+        void set_starvation_limit(std::chrono::nanoseconds limit) { _starvation_limit = limit.count(); }
+        std::chrono::nanoseconds get_starvation_limit() const { return std::chrono::nanoseconds { _starvation_limit.load() }; }
+        void count_promotion() { _promotions.fetch_add(1, std::memory_order_relaxed); }
+
+        task_lane_metrics metrics() const
+        {
+            task_lane_metrics result;
+
+            result.submitted = _submitted.load(std::memory_order_relaxed);
+            result.started = _started.load(std::memory_order_relaxed);
+            result.deadline_misses = _deadline_misses.load(std::memory_order_relaxed);
+            result.starvation_promotions = _promotions.load(std::memory_order_relaxed);
+            result.total_wait = std::chrono::nanoseconds { _total_wait.load(std::memory_order_relaxed) };
+            result.max_wait = std::chrono::nanoseconds { _max_wait.load(std::memory_order_relaxed) };
+            result.queued = _count.load(std::memory_order_relaxed);
+
+            return result;
+        }
+
+    private:
+        static bool later(const lane_entry& left, const lane_entry& right)
+        {
+            return left.deadline != right.deadline ? left.deadline > right.deadline : left.sequence > right.sequence;
+        }
+
+        void push_locked(thread_task_base* task, int64_t enqueued, int64_t deadline)
+        {
+            bool explicit_deadline { deadline != no_deadline };
+
+            if (!explicit_deadline) deadline = enqueued + _starvation_limit.load(std::memory_order_relaxed);
+
+            lane_entry entry { task, enqueued, deadline, _sequence++ };
+
+            if (explicit_deadline)
+            {
+                _heap.push_back(entry);
+
+                std::push_heap(std::begin(_heap), std::end(_heap), later);
+            }
+            else push_ring(entry);
+
+            _submitted.fetch_add(1, std::memory_order_relaxed);
+
+            published();
+        }
+
+        void push_ring(const lane_entry& entry)
+        {
+            auto capacity { std::size(_ring) };
+
+            if (_ring_count == capacity)
+            {
+                std::vector<lane_entry> entries(std::max<size_t>(capacity * 2, 64));
+
+                for (size_t index = 0; index < _ring_count; ++index) entries[index] = _ring[(_ring_head + index) % capacity];
+
+                _ring.swap(entries);
+                _ring_head = 0;
+                capacity = std::size(_ring);
+            }
+
+            _ring[(_ring_head + _ring_count++) % capacity] = entry;
+        }
+
+        void published()
+        {
+            auto earliest { no_deadline };
+
+            if (_ring_count > 0) earliest = _ring[_ring_head].deadline;
+            if (!std::empty(_heap)) earliest = std::min(earliest, _heap.front().deadline);
+
+            _earliest.store(earliest, std::memory_order_release);
+            _count.store(_ring_count + std::size(_heap), std::memory_order_release);
+        }
+
+        std::mutex _mutex {};
+        std::vector<lane_entry> _ring {};
+        size_t _ring_head { 0 };
+        size_t _ring_count { 0 };
+        std::vector<lane_entry> _heap {};
+        uint64_t _sequence { 0 };
+        std::atomic_size_t _count { 0 };
+        std::atomic<int64_t> _earliest { no_deadline };
+        std::atomic<int64_t> _starvation_limit { 0 };
+        std::atomic_uint64_t _submitted { 0 };
+        std::atomic_uint64_t _started { 0 };
+        std::atomic_uint64_t _deadline_misses { 0 };
+        std::atomic_uint64_t _promotions { 0 };
+        std::atomic_uint64_t _total_wait { 0 };
+        std::atomic_uint64_t _max_wait { 0 };
+    };
+
 public:
+    using timer_state = timer_service::timer_state;
+    using timer_handle = timer_service::timer_handle;
+
     explicit thread_pool(long num_threads = std::max(std::thread::hardware_concurrency(), 2u) - 1u)
     {
         if (num_threads < 1) num_threads = 1;
 
+        while (--num_threads >= 0) _worker_queues.push_back(std::make_unique<task_deque>());
+
+        lane(task_priority::normal).set_starvation_limit(std::chrono::milliseconds { 100 });
+        lane(task_priority::low).set_starvation_limit(std::chrono::seconds { 1 });
+
         try
         {
-            while (--num_threads >= 0) _worker_threads.emplace_back(&thread_pool::worker, this);
+            for (size_t index = 0; index < std::size(_worker_queues); ++index) _worker_threads.emplace_back(&thread_pool::worker, this, index);
         }
         catch(...)
         {
@@ -253,53 +811,537 @@ public:
     thread_pool& operator=(const thread_pool& rhs) = delete;
     ~thread_pool() { destroy(); }
 
-    template <typename Functor, typename... Args>
-    auto enqueue(Functor&& functor, Args&&... args)
+    // tasks posted from a worker of this pool go to the worker's own deque and run LIFO
+    // there, other tasks go to the normal lane; idle workers steal from both
+    template <typename Functor>
+    void post(Functor&& functor)
     {
-        auto bound_task = std::bind(std::forward<Functor>(functor), std::forward<Args>(args)...);
-        using result_type = std::result_of_t<decltype(bound_task)()>;
-        using packaged_task = std::packaged_task<result_type()>;
-        using task_type = thread_task<packaged_task>;
-        
-        packaged_task task{ std::move(bound_task) };
-        std::future<result_type> result { task.get_future() };
+        schedule(make_task(std::forward<Functor>(functor)));
+    }
+
+    // workers take the high lane first, then their own deque and the normal lane, then steal,
+    // and only then take the low lane; see set_starvation_limit for the exceptions
+    template <typename Functor>
+    void post(task_priority priority, Functor&& functor)
+    {
+        schedule(make_task(std::forward<Functor>(functor)), priority, no_deadline);
+    }
+
+    // within a lane, tasks run in earliest-deadline-first order
+    template <typename Functor>
+    void post_before(std::chrono::steady_clock::time_point deadline, Functor&& functor, task_priority priority = task_priority::normal)
+    {
+        schedule(make_task(std::forward<Functor>(functor)), priority, deadline.time_since_epoch() / std::chrono::nanoseconds { 1 });
+    }
+
+    template <typename Functor>
+    auto submit(Functor&& functor)
+    {
+        auto [task, result] { make_submitted_task(std::forward<Functor>(functor)) };
+
+        schedule(std::move(task));
+
+        return std::move(result);
+    }
+
+    template <typename Functor>
+    auto submit(task_priority priority, Functor&& functor)
+    {
+        auto [task, result] { make_submitted_task(std::forward<Functor>(functor)) };
+
+        schedule(std::move(task), priority, no_deadline);
 
-        _task_queue.push(std::make_unique<task_type>(std::move(task)));
+        return std::move(result);
+    }
+
+    template <typename Functor>
+    auto submit_before(std::chrono::steady_clock::time_point deadline, Functor&& functor, task_priority priority = task_priority::normal)
+    {
+        auto [task, result] { make_submitted_task(std::forward<Functor>(functor)) };
+
+        schedule(std::move(task), priority, deadline.time_since_epoch() / std::chrono::nanoseconds { 1 });
+
+        return std::move(result);
+    }
+
+    // submits every callable of the range with a single lock of the normal lane
+    template <std::input_iterator Iterator>
+    auto enqueue_bulk(Iterator first, Iterator last)
+    {
+        using result_type = std::invoke_result_t<std::decay_t<std::iter_reference_t<Iterator>>&>;
+
+        std::vector<task_pointer> tasks;
+        std::vector<std::future<result_type>> results;
+
+        if constexpr (std::forward_iterator<Iterator>)
+        {
+            auto count { static_cast<size_t>(std::distance(first, last)) };
+
+            tasks.reserve(count);
+            results.reserve(count);
+        }
+
+        for (; first != last; ++first)
+        {
+            auto [task, result] { make_submitted_task(*first) };
+
+            tasks.push_back(std::move(task));
+            results.push_back(std::move(result));
+        }
+
+        schedule_bulk(tasks);
+
+        return results;
+    }
+
+    // the calling thread takes part in the loop; the range is split into chunks of at least
+    // grain items that shrink as the loop progresses, and the first exception is rethrown
+    // once the chunks already started have finished
+    template <std::integral Index, typename Functor>
+    void parallel_for(Index first, Index last, size_t grain, Functor&& functor)
+    {
+        if (!(first < last)) return;
+
+        auto chunk { [first, &functor](size_t begin, size_t end)
+        {
+            for (auto index { begin }; index < end; ++index) functor(static_cast<Index>(first + static_cast<Index>(index)));
+        } };
+
+        run_chunks(static_cast<size_t>(last - first), grain, chunk);
+    }
+
+    template <std::ranges::random_access_range Range, typename Functor>
+    void parallel_for(Range&& range, size_t grain, Functor&& functor)
+    {
+        auto items { std::ranges::begin(range) };
+        auto chunk { [items, &functor](size_t begin, size_t end)
+        {
+            for (auto index { begin }; index < end; ++index) functor(items[static_cast<std::ranges::range_difference_t<Range>>(index)]);
+        } };
+
+        run_chunks(static_cast<size_t>(std::ranges::distance(range)), grain, chunk);
+    }
+
+    // reduce must be associative and commutative: chunks are combined in completion order
+    template <std::integral Index, typename T, typename Reduce, typename Transform>
+    T parallel_reduce(Index first, Index last, size_t grain, T identity, Reduce reduce, Transform transform)
+    {
+        T result { identity };
+        std::mutex result_mutex;
+
+        if (!(first < last)) return result;
+
+        auto chunk { [&](size_t begin, size_t end)
+        {
+            T partial { identity };
+
+            for (auto index { begin }; index < end; ++index) partial = reduce(std::move(partial), transform(static_cast<Index>(first + static_cast<Index>(index))));
+
+            std::scoped_lock lock { result_mutex };
+
+            result = reduce(std::move(result), std::move(partial));
+        } };
+
+        run_chunks(static_cast<size_t>(last - first), grain, chunk);
 
         return result;
     }
 
+    template <std::ranges::random_access_range Range, typename T, typename Reduce, typename Transform = std::identity>
+    T parallel_reduce(Range&& range, size_t grain, T identity, Reduce reduce, Transform transform = {})
+    {
+        auto items { std::ranges::begin(range) };
+
+        return parallel_reduce(std::ranges::range_difference_t<Range> { 0 }, std::ranges::distance(range), grain, std::move(identity), std::move(reduce),
+            [items, &transform](auto index) -> decltype(auto) { return transform(items[index]); });
+    }
+
+    template <typename Functor, typename... Args>
+    auto enqueue(Functor&& functor, Args&&... args)
+    {
+        return submit([functor = std::forward<Functor>(functor), ...args = std::forward<Args>(args)]() mutable -> decltype(auto)
+        {
+            return std::invoke(functor, unwrap_argument(args)...);
+        });
+    }
+
     auto size() const { return std::size(_worker_threads); }
 
+    // a task queued without a deadline is due its starvation limit after it was queued; once the
+    // earliest due task of the normal or low lane is overdue and due before the head of the high
+    // lane, it runs ahead of its turn (defaults: high 0, normal 100ms, low 1s)
+    void set_starvation_limit(task_priority priority, std::chrono::nanoseconds limit)
+    {
+        lane(priority).set_starvation_limit(limit);
+    }
+
+    std::chrono::nanoseconds get_starvation_limit(task_priority priority) const
+    {
+        return lane(priority).get_starvation_limit();
+    }
+
+    // tasks posted without a priority from a worker of this pool bypass the lanes and are not counted
+    task_lane_metrics get_lane_metrics(task_priority priority) const
+    {
+        return lane(priority).metrics();
+    }
+
+    // the callback is posted to the given lane when the delay has passed; the timers of the pool
+    // are kept by a timer_service of its own, whose clock thread is started with the first timer
+    template <typename Duration, typename Functor>
+    timer_handle schedule_after(const Duration& delay, Functor&& functor, task_priority priority = task_priority::normal)
+    {
+        return _timer_service->schedule_after(delay, std::forward<Functor>(functor), lane_executor(priority));
+    }
+
+    // the first run is one period from now; the next one is armed when a run has finished and
+    // periods that have already passed by then are skipped, so runs never overlap
+    template <typename Duration, typename Functor>
+    timer_handle schedule_every(const Duration& period, Functor&& functor, task_priority priority = task_priority::normal)
+    {
+        return _timer_service->schedule_every(period, std::forward<Functor>(functor), lane_executor(priority));
+    }
+
+    // returns true if the timer was cancelled before its next run was handed to the pool; a callback
+    // that is running is waited for, unless cancel is called from that callback
+    bool cancel(const timer_handle& handle)
+    {
+        return _timer_service && _timer_service->cancel(handle);
+    }
+
+    // cancelled timers are counted until their deadline is reached
+    size_t timer_count() const
+    {
+        return _timer_service ? _timer_service->size() : 0;
+    }
+
+    bool running_in_this_thread() const
+    {
+        return _this_worker.pool == this;
+    }
+
     operator bool ()
     {
         return !_cancelled;
     }
 
 private:
-    void worker()
+    // arguments are unwrapped from std::reference_wrapper as std::bind did
+    template <typename T>
+    static std::unwrap_reference_t<T>& unwrap_argument(T& argument)
+    {
+        return argument;
+    }
+
+    struct loop_state
+    {
+        loop_state(size_t count, size_t grain, size_t participants) : count { count }, grain { grain }, participants { participants } { }
+
+        const size_t count;
+        const size_t grain;
+        const size_t participants;
+        std::atomic_size_t next { 0 };
+        std::atomic_size_t active { 0 };
+        std::mutex error_mutex {};
+        std::exception_ptr error {};
+    };
+
+    template <typename Functor>
+    static task_pointer make_task(Functor&& functor)
+    {
+        using task_type = thread_task<std::decay_t<Functor>>;
+
+        if constexpr (task_slot_pool::fits<task_type>)
+        {
+            auto slot { task_slot_pool::allocate() };
+
+            try
+            {
+                return task_pointer { ::new (slot) task_type { std::forward<Functor>(functor) } };
+            }
+            catch(...)
+            {
+                task_slot_pool::deallocate(slot);
+                throw;
+            }
+        }
+        else return task_pointer { new task_type { std::forward<Functor>(functor) } };
+    }
+
+    template <typename Functor>
+    static auto make_submitted_task(Functor&& functor)
+    {
+        using result_type = std::invoke_result_t<std::decay_t<Functor>&>;
+
+        std::promise<result_type> promise { std::allocator_arg, task_slot_allocator<std::byte> {} };
+        std::future<result_type> result { promise.get_future() };
+
+        auto task { make_task([promise = std::move(promise), functor = std::forward<Functor>(functor)]() mutable
+        {
+            try
+            {
+                if constexpr (std::is_void_v<result_type>) functor(), promise.set_value();
+                else promise.set_value(functor());
+            }
+            catch(...)
+            {
+                promise.set_exception(std::current_exception());
+            }
+        }) };
+
+        return std::pair { std::move(task), std::move(result) };
+    }
+
+    // helpers that start after the loop is over find no chunk left and only touch the shared state
+    template <typename ChunkFunctor>
+    void run_chunks(size_t count, size_t grain, ChunkFunctor& chunk)
     {
+        grain = std::max<size_t>(grain, 1);
+
+        auto helpers { std::min(size(), (count + grain - 1) / grain - 1) };
+
+        if (helpers == 0) return chunk(size_t { 0 }, count);
+
+        auto state { std::allocate_shared<loop_state>(task_slot_allocator<loop_state> {}, count, grain, helpers + 1) };
+
+        for (size_t helper = 0; helper < helpers; ++helper) post([state, &chunk]{ run_loop(*state, chunk); });
+
+        run_loop(*state, chunk);
+
+        for (auto active { state->active.load() }; active != 0; active = state->active.load()) state->active.wait(active);
+
+        if (state->error) std::rethrow_exception(state->error);
+    }
+
+    template <typename ChunkFunctor>
+    static void run_loop(loop_state& state, ChunkFunctor& chunk)
+    {
+        while (true)
+        {
+            state.active.fetch_add(1);
+
+            auto remaining { state.count - std::min(state.next.load(), state.count) };
+            auto length { std::max(state.grain, remaining / (2 * state.participants)) };
+            auto begin { state.next.fetch_add(length) };
+            bool done { begin >= state.count };
+
+            if (!done)
+            {
+                try
+                {
+                    chunk(begin, std::min(begin + length, state.count));
+                }
+                catch(...)
+                {
+                    std::scoped_lock lock { state.error_mutex };
+
+                    if (!state.error) state.error = std::current_exception();
+
+                    state.next.store(state.count);
+                }
+            }
+
+            if (state.active.fetch_sub(1) == 1) state.active.notify_all();
+
+            if (done) return;
+        }
+    }
+
+    task_lane& lane(task_priority priority)
+    {
+        return _lanes[static_cast<size_t>(priority)];
+    }
+
+    const task_lane& lane(task_priority priority) const
+    {
+        return _lanes[static_cast<size_t>(priority)];
+    }
+
+    void schedule(task_pointer task)
+    {
+        if (_this_worker.pool != this) return schedule(std::move(task), task_priority::normal, no_deadline);
+
+        _worker_queues[_this_worker.index]->push(task.release());
+        _pending.fetch_add(1);
+
+        wake(1);
+    }
+
+    void schedule(task_pointer task, task_priority priority, int64_t deadline)
+    {
+        lane(priority).push(task.get(), now_ns(), deadline);
+
+        (void)task.release();
+
+        _pending.fetch_add(1);
+
+        wake(1);
+    }
+
+    void schedule_bulk(std::vector<task_pointer>& tasks)
+    {
+        if (std::empty(tasks)) return;
+
+        if (_this_worker.pool == this) for (auto& task : tasks) _worker_queues[_this_worker.index]->push(task.release());
+        else lane(task_priority::normal).push(tasks, now_ns());
+
+        _pending.fetch_add(static_cast<int64_t>(std::size(tasks)));
+
+        wake(std::size(tasks));
+    }
+
+    // the pending count is raised after a task is published, so it may briefly drop below zero
+    void wake(size_t count)
+    {
+        if (_sleeping.load() == 0) return;
+
+        { std::scoped_lock lock { _sleep_mutex }; }
+
+        if (count > 1) _wake_condition.notify_all();
+        else _wake_condition.notify_one();
+    }
+
+    bool pop_lane(task_priority priority, thread_task_base*& task)
+    {
+        auto& selected { lane(priority) };
+
+        return !selected.empty() && selected.pop(task, now_ns());
+    }
+
+    bool pop_prioritized(thread_task_base*& task)
+    {
+        auto& high { lane(task_priority::high) };
+
+        if (lane(task_priority::normal).empty() && lane(task_priority::low).empty()) return pop_lane(task_priority::high, task);
+
+        auto now { now_ns() };
+        auto earliest { high.empty() ? no_deadline : high.earliest_deadline() };
+        task_lane* starved { nullptr };
+
+        for (auto priority : { task_priority::normal, task_priority::low })
+        {
+            auto& candidate { lane(priority) };
+            auto deadline { candidate.earliest_deadline() };
+
+            if (!candidate.empty() && deadline < now && deadline < earliest) starved = &candidate, earliest = deadline;
+        }
+
+        if (starved && starved->pop(task, now))
+        {
+            starved->count_promotion();
+
+            return true;
+        }
+
+        return !high.empty() && high.pop(task, now);
+    }
+
+    bool steal(size_t thief, std::minstd_rand& random, thread_task_base*& task)
+    {
+        auto count { std::size(_worker_queues) };
+
+        if (count < 2) return false;
+
+        auto first { random() % count };
+
+        for (size_t offset = 0; offset < count; ++offset)
+        {
+            auto victim { (first + offset) % count };
+
+            if (victim != thief && _worker_queues[victim]->steal(task)) return true;
+        }
+
+        return false;
+    }
+
+    task_pointer take_task(size_t index, std::minstd_rand& random)
+    {
+        thread_task_base* task { nullptr };
+
+        if (!pop_prioritized(task) && !_worker_queues[index]->pop(task) && !pop_lane(task_priority::normal, task) && !steal(index, random, task)
+            && !pop_lane(task_priority::low, task)) return nullptr;
+
+        _pending.fetch_sub(1, std::memory_order_relaxed);
+
+        return task_pointer { task };
+    }
+
+    void worker(size_t index)
+    {
+        constexpr int spin_rounds { 64 };
+
+        _this_worker = { this, index };
+
+        std::minstd_rand random { static_cast<std::minstd_rand::result_type>(index + 1) };
+        int idle_rounds { 0 };
+
         while(!_cancelled)
         {
-            std::unique_ptr<thread_task_base> task { nullptr };
+            if (auto task { take_task(index, random) })
+            {
+                task->execute();
+                idle_rounds = 0;
+
+                continue;
+            }
+
+            if (_pending.load() > 0 || ++idle_rounds < spin_rounds)
+            {
+                std::this_thread::yield();
 
-            if(_task_queue.wait_pop(task)) task->execute();
+                continue;
+            }
+
+            std::unique_lock lock { _sleep_mutex };
+
+            ++_sleeping;
+
+            _wake_condition.wait(lock, [this]{ return _cancelled || _pending.load() > 0; });
+
+            --_sleeping;
+            idle_rounds = 0;
         }
     }
 
+    timer_service::executor_type lane_executor(task_priority priority)
+    {
+        return [this, priority](timer_service::task_type&& task){ schedule(make_task(std::move(task)), priority, no_deadline); };
+    }
+
+    // the timers are stopped first, so they post nothing once the workers are gone; their runs
+    // still queued then find the timer service destroyed and skip their callbacks
     void destroy()
     {
-        _cancelled = true;
+        _timer_service.reset();
 
-        _task_queue.invalidate();
+        {
+            std::scoped_lock lock { _sleep_mutex };
+
+            _cancelled = true;
+        }
+
+        _wake_condition.notify_all();
 
         for(auto& thread : _worker_threads) if(thread.joinable()) thread.join();
+
+        thread_task_base* task { nullptr };
+
+        for (auto& queue : _worker_queues) while (queue->pop(task)) task->release();
+        for (auto& queued : _lanes) while (queued.pop(task, 0)) task->release();
     }
 
 private:
+    static inline thread_local worker_context _this_worker {};
+
     std::atomic_bool _cancelled { false };
-    thread_safe_queue<std::unique_ptr<thread_task_base>> _task_queue {};
+    std::vector<std::unique_ptr<task_deque>> _worker_queues {};
+    std::array<task_lane, lane_count> _lanes {};
+    std::atomic<int64_t> _pending { 0 };
+    std::atomic_int _sleeping { 0 };
+    std::mutex _sleep_mutex {};
+    std::condition_variable _wake_condition {};
     std::deque<std::thread> _worker_threads {};
+    std::unique_ptr<timer_service> _timer_service { std::make_unique<timer_service>() };
 };
 
 namespace global_thread_pool
@@ -0,0 +1,394 @@
+#pragma once
+
+/*
+MIT License
+Copyright (c) 2019 Arlen Keshabyan (arlen.albert@gmail.com)
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "small_function.hpp"
+
+namespace nstd
+{
+
+/**
+ * @brief A timer service that keeps absolute deadlines in a min-heap served by a single clock thread
+ * 
+ * The clock thread is started with the first timer. Expired timers are handed over to
+ * the executor, which runs them inline on the clock thread unless another one is given
+ * (e.g. posting to a thread pool); a timer may also be scheduled with an executor of its
+ * own. Periodic timers are rescheduled against their previous deadline rather than the
+ * time they ran at, so the latency of a tick does not accumulate over the following
+ * periods; ticks missed entirely are skipped. The next tick is armed once a run has
+ * finished, so the runs of a timer never overlap.
+ * 
+ * Tasks handed over to the executor share the state of the service rather than refer
+ * to it, so the executor may outlive the service; such tasks no longer run their
+ * callbacks once the service is destroyed.
+ */
+class timer_service
+{
+public:
+    using clock_type = std::chrono::steady_clock;
+    using task_type = small_function<void()>;
+    using executor_type = small_function<void(task_type &&)>;
+
+    /**
+     * @brief State of a scheduled timer
+     */
+    enum class timer_state { scheduled, running, done, cancelled };
+
+    /**
+     * @brief A scheduled timer
+     */
+    struct timer
+    {
+        clock_type::time_point deadline {};
+        std::atomic<std::chrono::nanoseconds> period { std::chrono::nanoseconds::zero() };
+        task_type callback {};
+        executor_type executor {};
+        std::atomic<timer_state> state { timer_state::scheduled };
+        bool executing { false };
+
+        /**
+         * @brief Gets the state of the timer
+         * @return The state
+         */
+        timer_state get_state() const noexcept
+        {
+            return state.load();
+        }
+    };
+
+    using timer_handle = std::shared_ptr<timer>;
+
+    /**
+     * @brief Constructor
+     * @param executor The executor that runs expired timers; timers run on the clock thread if it is empty
+     */
+    explicit timer_service(executor_type &&executor = {}) : _state{ std::make_shared<shared_state>() }
+    {
+        set_executor(std::move(executor));
+    }
+
+    timer_service(const timer_service &other) = delete;
+    timer_service &operator=(const timer_service &other) = delete;
+
+    /**
+     * @brief Destructor that stops the clock thread and drops the pending timers
+     * 
+     * Waits for the callbacks that are running, except the one calling it. Tasks still
+     * queued in the executor are left there and skip their callbacks.
+     */
+    ~timer_service()
+    {
+        {
+            std::scoped_lock lock(_state->lock);
+
+            _state->stopping = true;
+        }
+
+        _state->clock_cv.notify_all();
+
+        if (_clock_thread.get_id() == std::this_thread::get_id()) _clock_thread.detach();
+        else if (_clock_thread.joinable()) _clock_thread.join();
+
+        std::unique_lock lock(_state->lock);
+
+        _state->timers.clear();
+        _state->done_cv.wait(lock, [this]{ return _state->executing == (_current_state == _state.get() ? 1u : 0u); });
+    }
+
+    /**
+     * @brief Gets the service shared by the whole process
+     * 
+     * Its timers run on its clock thread one after another until it is given an executor
+     * with set_executor.
+     * 
+     * @return Reference to the process-wide timer service
+     */
+    static timer_service &global()
+    {
+        static timer_service service {};
+
+        return service;
+    }
+
+    /**
+     * @brief Sets the executor that runs expired timers
+     * 
+     * The executor must stay valid until it is replaced or the service is destroyed.
+     * 
+     * @param executor The executor; timers run on the clock thread if it is empty
+     */
+    void set_executor(executor_type &&executor)
+    {
+        auto new_executor { executor ? std::make_shared<executor_type>(std::move(executor)) : nullptr };
+
+        std::scoped_lock lock(_state->lock);
+
+        _state->executor = std::move(new_executor);
+    }
+
+    /**
+     * @brief Schedules a callback to run once at a deadline
+     * @param deadline The absolute deadline
+     * @param callback The callback to run
+     * @param executor The executor to run the timer on instead of the service's one
+     * @return Handle that can be used to cancel the timer
+     */
+    timer_handle schedule_at(clock_type::time_point deadline, task_type &&callback, executor_type &&executor = {})
+    {
+        return schedule(deadline, std::chrono::nanoseconds::zero(), std::move(callback), std::move(executor));
+    }
+
+    /**
+     * @brief Schedules a callback to run once after a delay
+     * @param delay The delay
+     * @param callback The callback to run
+     * @param executor The executor to run the timer on instead of the service's one
+     * @return Handle that can be used to cancel the timer
+     */
+    template<typename Duration>
+    timer_handle schedule_after(const Duration &delay, task_type &&callback, executor_type &&executor = {})
+    {
+        return schedule(clock_type::now() + std::chrono::duration_cast<clock_type::duration>(delay), std::chrono::nanoseconds::zero(), std::move(callback), std::move(executor));
+    }
+
+    /**
+     * @brief Schedules a callback to run periodically, the first time one period from now
+     * @param period The period
+     * @param callback The callback to run
+     * @param executor The executor to run the timer on instead of the service's one
+     * @return Handle that can be used to cancel the timer
+     */
+    template<typename Duration>
+    timer_handle schedule_every(const Duration &period, task_type &&callback, executor_type &&executor = {})
+    {
+        auto nanoseconds_period { std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(period), std::chrono::nanoseconds{ 1 }) };
+
+        return schedule(clock_type::now() + nanoseconds_period, nanoseconds_period, std::move(callback), std::move(executor));
+    }
+
+    /**
+     * @brief Cancels a timer
+     * 
+     * If the callback is running on another thread, waits for it to finish; called from
+     * within the timer's own callback, it returns immediately.
+     * 
+     * @param handle The timer to cancel
+     * @return true if the timer was waiting for its next run, false otherwise
+     */
+    bool cancel(const timer_handle &handle)
+    {
+        if (!handle) return false;
+
+        std::unique_lock lock(_state->lock);
+
+        auto previous { handle->state.load() };
+
+        if (previous == timer_state::done || previous == timer_state::cancelled) return false;
+
+        handle->state = timer_state::cancelled;
+
+        if (_current_timer != handle.get()) _state->done_cv.wait(lock, [&handle]{ return !handle->executing; });
+
+        return previous == timer_state::scheduled;
+    }
+
+    /**
+     * @brief Gets the number of pending timers
+     * @return Number of timers in the heap, including cancelled ones not reached yet
+     */
+    size_t size() const
+    {
+        std::scoped_lock lock(_state->lock);
+
+        return std::size(_state->timers);
+    }
+
+private:
+    /**
+     * @brief The state shared by the service and the tasks handed over to its executor
+     */
+    struct shared_state
+    {
+        std::vector<timer_handle> timers {};
+        std::shared_ptr<executor_type> executor {};
+        uint32_t executing { 0 };
+        bool stopping { false };
+        std::mutex lock {};
+        std::condition_variable clock_cv {}, done_cv {};
+    };
+
+    static inline thread_local const shared_state *_current_state { nullptr };
+    static inline thread_local const timer *_current_timer { nullptr };
+
+    std::shared_ptr<shared_state> _state;
+    std::once_flag _clock_started {};
+    std::jthread _clock_thread {};
+
+    static bool later(const timer_handle &left, const timer_handle &right) noexcept
+    {
+        return left->deadline > right->deadline;
+    }
+
+    /**
+     * @brief Puts a timer into the heap; the caller must hold the lock
+     */
+    static void arm(shared_state &state, timer_handle t)
+    {
+        state.timers.push_back(std::move(t));
+
+        std::push_heap(std::begin(state.timers), std::end(state.timers), later);
+    }
+
+    timer_handle schedule(clock_type::time_point deadline, std::chrono::nanoseconds period, task_type &&callback, executor_type &&executor)
+    {
+        auto new_timer { std::make_shared<timer>() };
+
+        new_timer->deadline = deadline;
+        new_timer->period = period;
+        new_timer->callback = std::move(callback);
+        new_timer->executor = std::move(executor);
+
+        bool earliest { false };
+
+        {
+            std::scoped_lock lock(_state->lock);
+
+            if (_state->stopping) return new_timer;
+
+            arm(*_state, new_timer);
+
+            earliest = _state->timers.front() == new_timer;
+        }
+
+        std::call_once(_clock_started, [this]{ _clock_thread = std::jthread([state = _state]{ clock_procedure(state); }); });
+
+        if (earliest) _state->clock_cv.notify_one();
+
+        return new_timer;
+    }
+
+    /**
+     * @brief Runs the timer callback unless the timer has been cancelled or the service stopped, and arms the next tick of a periodic timer
+     */
+    static void run(shared_state &state, const timer_handle &t)
+    {
+        {
+            std::scoped_lock lock(state.lock);
+
+            if (state.stopping || t->state.load() != timer_state::running) return;
+
+            t->executing = true;
+            ++state.executing;
+        }
+
+        auto previous_state { std::exchange(_current_state, &state) };
+        auto previous_timer { std::exchange(_current_timer, t.get()) };
+
+        t->callback();
+
+        _current_state = previous_state;
+        _current_timer = previous_timer;
+
+        bool earliest { false };
+
+        {
+            std::scoped_lock lock(state.lock);
+
+            t->executing = false;
+            --state.executing;
+
+            auto expected { timer_state::running };
+
+            if (auto period { t->period.load() }; period > std::chrono::nanoseconds::zero() && !state.stopping)
+            {
+                if (t->state.compare_exchange_strong(expected, timer_state::scheduled))
+                {
+                    auto now { clock_type::now() };
+
+                    t->deadline += period;
+
+                    if (t->deadline <= now) t->deadline = now + period - (now - t->deadline) % period;
+
+                    arm(state, t);
+
+                    earliest = state.timers.front() == t;
+                }
+            }
+            else t->state.compare_exchange_strong(expected, timer_state::done);
+        }
+
+        state.done_cv.notify_all();
+
+        if (earliest) state.clock_cv.notify_one();
+    }
+
+    static void clock_procedure(const std::shared_ptr<shared_state> &shared)
+    {
+        auto &state { *shared };
+        std::unique_lock lock(state.lock);
+
+        while (!state.stopping)
+        {
+            if (std::empty(state.timers))
+            {
+                state.clock_cv.wait(lock, [&state]{ return state.stopping || !std::empty(state.timers); });
+
+                continue;
+            }
+
+            auto deadline { state.timers.front()->deadline };
+
+            if (state.clock_cv.wait_until(lock, deadline, [&state, deadline]{ return state.stopping || std::empty(state.timers) || state.timers.front()->deadline < deadline; })) continue;
+
+            std::pop_heap(std::begin(state.timers), std::end(state.timers), later);
+
+            auto t { std::move(state.timers.back()) };
+
+            state.timers.pop_back();
+
+            auto expected { timer_state::scheduled };
+
+            if (!t->state.compare_exchange_strong(expected, timer_state::running)) continue;
+
+            auto executor { state.executor };
+
+            lock.unlock();
+
+            if (t->executor) t->executor([shared, t]{ run(*shared, t); });
+            else if (executor) (*executor)([shared, t]{ run(*shared, t); });
+            else run(state, t);
+
+            lock.lock();
+        }
+    }
+};
+
+}
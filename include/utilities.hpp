@@ -38,6 +38,7 @@ SOFTWARE.
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include "thread_pool.hpp"
 
 namespace nstd::utilities
 {
@@ -284,6 +285,33 @@ void parallel_sort(Iterator begin, Iterator end, size_t min_sortable_length, con
     }
 }
 
+template<class Iterator, class Compare = std::less<>>
+void parallel_sort(nstd::thread_pool &pool, Iterator begin, Iterator end, size_t min_sortable_length, const Compare &cp = Compare())
+{
+    using difference_type = typename std::iterator_traits<Iterator>::difference_type;
+
+    const auto size { static_cast<size_t>(std::distance(begin, end)) };
+    const auto run_length { std::max<size_t>(min_sortable_length, 1) };
+    const auto at { [begin](size_t index){ return begin + static_cast<difference_type>(index); } };
+
+    pool.parallel_for(size_t { 0 }, (size + run_length - 1) / run_length, 1, [&](size_t run)
+    {
+        std::sort(at(run * run_length), at(std::min(size, (run + 1) * run_length)), cp);
+    });
+
+    for (auto width { run_length }; width < size; width *= 2)
+    {
+        pool.parallel_for(size_t { 0 }, (size + 2 * width - 1) / (2 * width), 1, [&](size_t pair)
+        {
+            const auto first { pair * 2 * width };
+            const auto mid { std::min(size, first + width) };
+            const auto last { std::min(size, first + 2 * width) };
+
+            if (mid < last) std::inplace_merge(at(first), at(mid), at(last), cp);
+        });
+    }
+}
+
 template<typename Iterator, typename Functor>
 static void parallel_for_each(Iterator begin, Iterator end, Functor func)
 {
@@ -310,6 +338,34 @@ static void parallel_for_each(Iterator begin, Iterator end, Functor func)
     for (std::thread &t : thread_pool) if (t.joinable()) t.join();
 }
 
+template<typename Iterator, typename Functor>
+static void parallel_for_each(nstd::thread_pool &pool, Iterator begin, Iterator end, Functor func)
+{
+    if constexpr (std::random_access_iterator<Iterator>) pool.parallel_for(std::ranges::subrange(begin, end), 0, func);
+    else
+    {
+        auto size { std::distance(begin, end) };
+        auto slice { std::max<decltype(size)>(size / static_cast<decltype(size)>(pool.size() + 1), 1) };
+        std::vector<Iterator> bounds { begin };
+
+        bounds.reserve(static_cast<size_t>(size / slice) + 2);
+
+        for (auto remaining { size }; remaining > 0;)
+        {
+            auto step { std::min(slice, remaining) };
+            auto next { bounds.back() };
+
+            std::advance(next, step);
+
+            remaining -= step;
+
+            bounds.push_back(next);
+        }
+
+        pool.parallel_for(size_t { 0 }, std::size(bounds) - 1, 1, [&](size_t index){ std::for_each(bounds[index], bounds[index + 1], func); });
+    }
+}
+
 template<class Iterator>
 void reverse_inplace(Iterator begin, Iterator end)
 {